@@ -0,0 +1,37 @@
+#ifndef ALLOC_COUNTER_HPP
+#define ALLOC_COUNTER_HPP
+
+#include <cstddef>
+
+/**
+ * @brief Number of calls to the global operator new since the program started.
+ *
+ * Counted only when MOUZE_COUNT_ALLOCS is defined (e.g.
+ * -DMOUZE_COUNT_ALLOCS): alloc_counter.cpp then replaces the global
+ * operator new of the whole program. Otherwise the standard operator new
+ * is kept, has_allocation_count() is false and allocation_count() is
+ * always 0. Used by the benchmarks to check that steady-state planning
+ * does not touch the heap.
+ */
+
+#ifdef MOUZE_COUNT_ALLOCS
+
+constexpr bool has_allocation_count(){
+    return true;
+}
+
+size_t allocation_count();
+
+#else
+
+constexpr bool has_allocation_count(){
+    return false;
+}
+
+inline size_t allocation_count(){
+    return 0;
+}
+
+#endif
+
+#endif
@@ -0,0 +1,223 @@
+#include "anytime_search.hpp"
+#include "level.hpp"
+#include "search.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    const int EXPANSIONS_PER_CHECK = 64; //expansões entre uma leitura do relógio e outra
+}
+
+/**
+ * @brief Starts a new search towards `goal`, discarding the previous one.
+ *
+ * @param level Level to search; must outlive the search.
+ * @param goal Cell the paths lead to.
+ * @param head Cell the heuristic points to in the first iteration.
+ */
+
+void AnytimeSearch::reset(const Level& lvl, Point goal_cell, Point head){
+    level = &lvl;
+    cols = lvl.cols;
+    goal = goal_cell;
+    target = head;
+    eps = EPSILON_START;
+    finished = false;
+    expanded = 0;
+
+    const size_t cells = (size_t)lvl.rows * lvl.cols;
+    g.assign(cells, UNREACHABLE);
+    parent.assign(cells, -1);
+    iteration = 1;
+    closed.assign(cells, 0);
+    incons.assign(cells, 0);
+    incons_list.clear();
+    open.clear();
+
+    g[index(goal)] = 0;
+    open.push_back({key(index(goal)), 0, index(goal)});
+}
+
+/**
+ * @brief Points the heuristic of the current iteration at another cell
+ * (e.g. the head after losing a life) and lets the search continue.
+ */
+
+void AnytimeSearch::retarget(Point head){
+    finished = false;
+    reopen(head);
+}
+
+double AnytimeSearch::key(int cell) const {
+    const int h = std::abs(cell / cols - target.x) + std::abs(cell % cols - target.y);
+    return g[cell] + eps * h;
+}
+
+/**
+ * @brief Runs search iterations until the budget is spent or the path is
+ * optimal.
+ *
+ * @param head Current head; later iterations aim the heuristic at it.
+ * @param budget Time allowed; zero means no limit.
+ * @return True if at least one iteration finished, i.e. path_from may now
+ * give a better path.
+ */
+
+bool AnytimeSearch::run(Point head, std::chrono::microseconds budget){
+    if(level == nullptr || finished){
+        return false;
+    }
+    const Clock::time_point deadline = budget.count() > 0 ? Clock::now() + budget : Clock::time_point::max();
+
+    bool improved = false;
+    while(improve_path(deadline)){
+        improved = true;
+        if(eps <= 1.0){
+            finished = true;
+            break;
+        }
+        eps = std::max(1.0, eps - EPSILON_STEP);
+        reopen(head);
+        if(Clock::now() >= deadline){
+            break;
+        }
+    }
+    return improved;
+}
+
+/**
+ * @brief ImprovePath of ARA*: expands states until the target's g is no
+ * larger than the smallest key in OPEN.
+ *
+ * States already expanded in this iteration that get a lower g go to
+ * INCONS instead of OPEN, so each state is expanded at most once per
+ * iteration.
+ *
+ * @return False if the deadline came first; the iteration then continues
+ * on the next call.
+ */
+
+bool AnytimeSearch::improve_path(Clock::time_point deadline){
+    const int t = index(target);
+    int checks = 0;
+
+    while(!open.empty()){
+        const Entry top = open.front();
+        if(top.g != g[top.cell] || closed[top.cell] == iteration){
+            std::pop_heap(open.begin(), open.end(), std::greater<>());
+            open.pop_back(); //entrada antiga
+            continue;
+        }
+        if(g[t] != UNREACHABLE && g[t] <= top.key){
+            return true;
+        }
+        if(++checks % EXPANSIONS_PER_CHECK == 0 && Clock::now() >= deadline){
+            return false;
+        }
+        std::pop_heap(open.begin(), open.end(), std::greater<>());
+        open.pop_back();
+
+        const int s = top.cell;
+        closed[s] = iteration;
+        ++expanded;
+
+        const int x = s / cols;
+        const int y = s % cols;
+        //de p para s custa o terreno de s
+        const int step = level->terrain_cost(level->board[x][y]);
+        for(const Point& move : MOVES){
+            const int nx = x + move.x;
+            const int ny = y + move.y;
+            if(!is_open_cell(*level, nx, ny)) continue;
+            const int p = nx * cols + ny;
+            if(g[s] + step >= g[p]) continue;
+            g[p] = g[s] + step;
+            parent[p] = s;
+            if(closed[p] != iteration){
+                open.push_back({key(p), g[p], p});
+                std::push_heap(open.begin(), open.end(), std::greater<>());
+            }else if(!incons[p]){
+                incons[p] = 1;
+                incons_list.push_back(p);
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Starts a new iteration: OPEN becomes OPEN plus INCONS with keys
+ * for the current epsilon and target, and CLOSED is emptied.
+ */
+
+void AnytimeSearch::reopen(Point head){
+    target = head;
+
+    //fica uma entrada por célula ainda aberta, depois entram as de INCONS
+    size_t kept = 0;
+    for(const Entry& entry : open){
+        if(entry.g == g[entry.cell] && closed[entry.cell] != iteration && !incons[entry.cell]){
+            incons[entry.cell] = 1; //marca para não repetir
+            open[kept++] = entry;
+        }
+    }
+    open.resize(kept);
+    for(int cell : incons_list){
+        open.push_back({0, g[cell], cell});
+    }
+    incons_list.clear();
+
+    ++iteration; //esvazia CLOSED
+    for(Entry& entry : open){
+        incons[entry.cell] = 0;
+        entry.key = key(entry.cell);
+    }
+    std::make_heap(open.begin(), open.end(), std::greater<>());
+}
+
+/**
+ * @brief Path from `head` to the goal by the best parents found so far.
+ *
+ * @param path Receives the cells after head, up to the goal.
+ * @return False if the search has not reached head yet.
+ */
+
+bool AnytimeSearch::path_from(Point head, std::vector<Point>& path) const {
+    path.clear();
+    if(!reached(head)){
+        return false;
+    }
+    const int goal_idx = index(goal);
+    for(int cell = index(head); cell != goal_idx && path.size() < g.size(); ){
+        cell = parent[cell];
+        path.push_back({cell / cols, cell % cols});
+    }
+    return true;
+}
+
+bool AnytimeSearch::reached(Point head) const {
+    return level != nullptr && g[index(head)] != UNREACHABLE;
+}
+
+/**
+ * @brief Whether this search is the one for `goal` on `level`.
+ */
+
+bool AnytimeSearch::has_goal(const Level& lvl, Point goal_cell) const {
+    return level == &lvl && goal == goal_cell;
+}
+
+bool AnytimeSearch::is_optimal() const {
+    return finished;
+}
+
+double AnytimeSearch::epsilon() const {
+    return eps;
+}
+
+size_t AnytimeSearch::nodes_expanded() const {
+    return expanded;
+}
@@ -0,0 +1,80 @@
+#ifndef ANYTIME_SEARCH_HPP
+#define ANYTIME_SEARCH_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "direction.hpp"
+
+class Level;
+
+/**
+ * @brief Anytime Repairing A* (ARA*) towards one goal, run in time slices.
+ *
+ * The search goes backwards from the goal, so g[c] is the cost from c to
+ * the goal and following the parents of any reached cell gives its path:
+ * the mouse can walk a path while later iterations improve it. The first
+ * iteration inflates the Manhattan heuristic by EPSILON_START, giving a
+ * path at most that many times the optimal cost quickly; each following
+ * iteration lowers the inflation by EPSILON_STEP and reuses the g values
+ * of the previous ones (only the states made inconsistent are reopened),
+ * down to 1, when the path is optimal.
+ *
+ * `run` stops when its time budget is spent and continues from the same
+ * state on the next call. The cell the heuristic points to (the head) may
+ * change between iterations; g values stay valid upper bounds.
+ */
+
+class AnytimeSearch {
+    public:
+        static constexpr double EPSILON_START = 3.0;
+        static constexpr double EPSILON_STEP = 0.5;
+
+        void reset(const Level& level, Point goal, Point head);
+        void retarget(Point head);
+        bool run(Point head, std::chrono::microseconds budget);
+        bool path_from(Point head, std::vector<Point>& path) const;
+
+        bool reached(Point head) const;
+        bool has_goal(const Level& level, Point goal) const;
+        bool is_optimal() const;
+        double epsilon() const;
+        size_t nodes_expanded() const;
+
+    private:
+        struct Entry {
+            double key;
+            int g;
+            int cell;
+
+            //menor chave primeiro; no empate, o mais fundo (maior g)
+            bool operator>(const Entry& other) const {
+                return key != other.key ? key > other.key : g < other.g;
+            }
+        };
+
+        const Level* level = nullptr;
+        int cols = 0;
+        Point goal{0, 0};
+        Point target{0, 0}; //célula para onde aponta a heurística
+        double eps = EPSILON_START;
+        bool finished = false; //iteração com eps = 1 concluída
+        size_t expanded = 0;
+
+        std::vector<int> g;
+        std::vector<int> parent; //próxima célula em direção ao objetivo
+        unsigned iteration = 1;
+        std::vector<unsigned> closed; //iteração em que a célula foi expandida
+        std::vector<std::uint8_t> incons; //na lista INCONS
+        std::vector<int> incons_list;
+        std::vector<Entry> open; //heap com std::greater
+
+        int index(Point p) const { return p.x * cols + p.y; }
+        double key(int cell) const;
+        bool improve_path(std::chrono::steady_clock::time_point deadline);
+        void reopen(Point head);
+};
+
+#endif
@@ -0,0 +1,97 @@
+#include "benchmark.hpp"
+#include "anytime_search.hpp"
+#include "compact_path.hpp"
+#include "maze.hpp"
+#include "player.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+/**
+ * @brief Plays the ARA* player tick by tick on large mazes.
+ *
+ * Each tick plans (or improves the path) within the budget and moves
+ * the head one cell, like the THINKING state. Reports how long a full
+ * A* blocks, the first tick (which also allocates the search arrays),
+ * the longest of the others, when the first path came and its cost
+ * against the optimal one, and after how many ticks the path walked
+ * became optimal; that last path must cost the same as an A* from the
+ * head at that moment.
+ */
+
+void bench_anytime(){
+    const long budget_us = 1000;
+    std::cout << "\n[ANYTIME ARA* (" << budget_us << " us per tick, epsilon " << AnytimeSearch::EPSILON_START
+              << " to 1 by " << AnytimeSearch::EPSILON_STEP << ")]\n";
+    std::cout << std::left << std::setw(12) << "maze" << std::right << std::setw(10) << "A* ms"
+              << std::setw(14) << "first tick" << std::setw(14) << "worst tick" << std::setw(12) << "first at" << std::setw(12) << "first cost"
+              << std::setw(10) << "optimal" << std::setw(14) << "optimal at" << "\n";
+
+    for(int side : {1001, 2001}){
+        Level maze = generate_maze(side, side, side + 2, 10, 30);
+        std::vector<Point> cells = open_cells(maze);
+        Point start = cells.front();
+        Point goal = cells.back();
+        maze.board[goal.x][goal.y] = '*';
+        maze.food_mouse = goal;
+
+        Player player(maze);
+        player.use_landmarks = false;
+        auto begin = Clock::now();
+        player.computed_path_A(start, goal);
+        double blocking_ms = elapsed_ms(begin);
+        int optimal = path_cost(maze, player.path);
+
+        player.plan_budget_us = budget_us;
+        CompactPath route;
+        CompactPath::Cursor step;
+        Point head = start;
+        int ticks = 0, first_tick = -1, first_cost = -1;
+        double setup_ms = 0, worst_ms = 0;
+        const int limit = 100000;
+        while(ticks < limit){
+            ++ticks;
+            begin = Clock::now();
+            if(step.done()){
+                player.computed_path_ara(head);
+                player.take_route(head, route);
+                step = route.begin();
+            }else if(player.improve_path_ara(head)){
+                player.take_route(head, route);
+                step = route.begin();
+            }
+            const double tick_ms = elapsed_ms(begin);
+            if(ticks == 1){
+                setup_ms = tick_ms;
+            }else{
+                worst_ms = std::max(worst_ms, tick_ms);
+            }
+
+            if(first_tick < 0 && !step.done()){
+                first_tick = ticks;
+                first_cost = path_cost(maze, player.path);
+            }
+            if(player.get_anytime_search()->is_optimal() || head == goal){
+                break;
+            }
+            if(!step.done()){
+                head = step.next();
+            }
+        }
+
+        const std::vector<Point> walked = player.path;
+        player.computed_path_A(head, goal);
+        bool converged = player.get_anytime_search()->is_optimal() && path_cost(maze, walked) == path_cost(maze, player.path);
+
+        std::string name = std::to_string(side) + "x" + std::to_string(side);
+        std::cout << std::left << std::setw(12) << name << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(10) << blocking_ms << std::setw(11) << setup_ms << " ms" << std::setw(11) << worst_ms << " ms"
+                  << std::setw(7) << first_tick << " tick" << std::setw(12) << first_cost
+                  << std::setw(10) << optimal << std::setw(8) << ticks << " ticks" << "\n";
+        if(!converged){
+            std::cout << "  ! path did not converge to the optimal cost\n";
+        }
+    }
+}
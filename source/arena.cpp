@@ -0,0 +1,64 @@
+#include "arena.hpp"
+
+#include <algorithm>
+
+ScratchArena::ScratchArena(size_t first_block){
+    blocks.push_back({std::make_unique<std::byte[]>(first_block), first_block});
+}
+
+/**
+ * @brief Makes all the memory of the arena available again.
+ *
+ * Blocks are kept, so the next search reuses them without allocating.
+ */
+
+void ScratchArena::reset(){
+    current = 0;
+    offset = 0;
+    used_before = 0;
+}
+
+/**
+ * @brief Total bytes held by the arena.
+ */
+
+size_t ScratchArena::capacity() const{
+    size_t total = 0;
+    for(const Block& block : blocks){
+        total += block.size;
+    }
+    return total;
+}
+
+/**
+ * @brief Bytes handed out since the last reset (including alignment and skipped tails).
+ */
+
+size_t ScratchArena::used() const{
+    return used_before + offset;
+}
+
+void* ScratchArena::do_allocate(size_t bytes, size_t alignment){
+    while(true){
+        Block& block = blocks[current];
+        size_t base = reinterpret_cast<size_t>(block.data.get());
+        size_t start = ((base + offset + alignment - 1) & ~(alignment - 1)) - base;
+        if(start + bytes <= block.size){
+            offset = start + bytes;
+            return block.data.get() + start;
+        }
+
+        //não coube: passa para o próximo bloco, criando um maior se preciso
+        used_before += block.size;
+        offset = 0;
+        ++current;
+        if(current == blocks.size()){
+            size_t size = std::max(blocks.back().size * 2, bytes + alignment);
+            blocks.push_back({std::make_unique<std::byte[]>(size), size});
+        }
+    }
+}
+
+bool ScratchArena::do_is_equal(const std::pmr::memory_resource& other) const noexcept{
+    return this == &other;
+}
@@ -0,0 +1,45 @@
+#ifndef ARENA_HPP
+#define ARENA_HPP
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+/**
+ * @brief Monotonic scratch memory for planner searches.
+ *
+ * Allocations only bump a pointer inside the current block and are never
+ * freed individually; `reset()` rewinds to the first block while keeping
+ * every block allocated so far. After the first few searches the arena has
+ * grown to the size the searches need and later ones do not touch the heap.
+ * Containers using it must not outlive the next `reset()`.
+ */
+
+class ScratchArena : public std::pmr::memory_resource {
+    public:
+        explicit ScratchArena(size_t first_block = 64 * 1024);
+        ScratchArena(const ScratchArena&) = delete;
+        ScratchArena& operator=(const ScratchArena&) = delete;
+
+        void reset();
+        size_t capacity() const;
+        size_t used() const;
+
+    private:
+        struct Block {
+            std::unique_ptr<std::byte[]> data;
+            size_t size;
+        };
+
+        std::vector<Block> blocks;
+        size_t current = 0;
+        size_t offset = 0;
+        size_t used_before = 0; //bytes dos blocos anteriores ao atual
+
+        void* do_allocate(size_t bytes, size_t alignment) override;
+        void do_deallocate(void*, size_t, size_t) override {}
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+};
+
+#endif
@@ -0,0 +1,53 @@
+#include "benchmark.hpp"
+#include "alloc_counter.hpp"
+#include "maze.hpp"
+#include "planner.hpp"
+
+#include <iomanip>
+#include <iostream>
+
+/**
+ * @brief Counts heap allocations made by each planner.
+ *
+ * Every planner answers the same random queries twice: the first pass
+ * lets the scratch arena and the reused vectors grow, the second one is
+ * the steady state, where no allocation is expected. The tour planner is
+ * left out: it plans once per level and spawns worker threads.
+ */
+
+void bench_alloc(){
+    if(!has_allocation_count()){
+        std::cout << "\n[HEAP ALLOCATIONS PER PLANNER]\n  skipped: needs a build with -DMOUZE_COUNT_ALLOCS\n";
+        return;
+    }
+    const int queries = 100;
+    Level maze = generate_maze(99, 99, 5, 15, 20);
+    Player player(maze);
+    const std::vector<PathQuery> pairs = QuerySampler(maze, 7).queries(queries);
+
+    std::cout << "\n[HEAP ALLOCATIONS PER PLANNER (" << queries << " queries on maze 99x99)]\n";
+    std::cout << std::left << std::setw(14) << "planner" << std::right << std::setw(14) << "warm-up"
+              << std::setw(14) << "steady" << std::setw(16) << "arena bytes" << "\n";
+
+    auto run = [&](auto tag){
+        using Planner = typename decltype(tag)::type;
+        if constexpr (!Planner::all_food) {
+            size_t counts[2];
+            for(int pass=0;pass<2;++pass){
+                size_t before = allocation_count();
+                for(const auto& [start, goal] : pairs){
+                    //a comida fica no objetivo, como no jogo
+                    char saved = maze.board[goal.x][goal.y];
+                    maze.board[goal.x][goal.y] = '*';
+                    maze.food_mouse = goal;
+                    Planner::plan(player, start);
+                    maze.board[goal.x][goal.y] = saved;
+                }
+                counts[pass] = allocation_count() - before;
+            }
+            std::cout << std::left << std::setw(14) << Planner::name << std::right << std::setw(14) << counts[0]
+                      << std::setw(14) << counts[1] << std::setw(16) << player.scratch_capacity() << "\n";
+        }
+    };
+    for_each_planner(run);
+}
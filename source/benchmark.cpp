@@ -0,0 +1,130 @@
+#include "benchmark.hpp"
+#include "maze.hpp"
+#include "simulation.hpp"
+
+#include <iostream>
+
+double elapsed_ms(Clock::time_point since){
+    return std::chrono::duration<double, std::milli>(Clock::now() - since).count();
+}
+
+std::vector<BenchBoard> terrain_boards(const std::vector<Level>& levels){
+    std::vector<BenchBoard> boards;
+    for(size_t i=0;i<levels.size();++i){
+        boards.push_back({"level " + std::to_string(i + 1), levels[i]});
+    }
+    boards.push_back({"maze 61x61 t30", generate_maze(61, 61, 1, 15, 30)});
+    boards.push_back({"maze 99x99 t50", generate_maze(99, 99, 2, 20, 50)});
+    boards.push_back({"open 99x99 t40", generate_maze(99, 99, 3, 70, 40)});
+    return boards;
+}
+
+std::vector<Point> open_cells(const Level& level){
+    std::vector<Point> cells;
+    for(int i=0;i<level.rows;++i){
+        for(int j=0;j<level.cols && j<(int)level.board[i].size();++j){
+            if(level.board[i][j] != '#'){
+                cells.push_back({i, j});
+            }
+        }
+    }
+    return cells;
+}
+
+int path_cost(const Level& level, const std::vector<Point>& path){
+    int cost = 0;
+    for(const Point& p : path){
+        cost += level.terrain_cost(level.board[p.x][p.y]);
+    }
+    return cost;
+}
+
+/**
+ * @brief Runs the benchmark selected with --bench and prints its report.
+ *
+ * Uses the levels loaded from the input file, if any, plus generated mazes.
+ * "all" runs every benchmark.
+ *
+ * @return False if a check failed (see bench_verify).
+ */
+
+bool MouzeSimulation::run_benchmarks(){
+    bool all = bench_section == "all";
+    bool ran = false;
+    bool ok = true;
+
+    std::cout << "\n=================================================\n";
+    std::cout << "              BENCHMARK REPORT\n";
+    std::cout << "=================================================\n";
+
+    if(all || bench_section == "alt"){
+        bench_alt(levels);
+        ran = true;
+    }
+    if(all || bench_section == "tour"){
+        bench_tour();
+        ran = true;
+    }
+    if(all || bench_section == "alloc"){
+        bench_alloc();
+        ran = true;
+    }
+    if(all || bench_section == "rollout"){
+        bench_rollout();
+        ran = true;
+    }
+    if(all || bench_section == "hda"){
+        bench_parallel_astar();
+        ran = true;
+    }
+    if(all || bench_section == "field"){
+        bench_distance_field();
+        ran = true;
+    }
+    if(all || bench_section == "batch"){
+        bench_batch(levels);
+        ran = true;
+    }
+    if(all || bench_section == "cpd"){
+        bench_cpd(levels);
+        ran = true;
+    }
+    if(all || bench_section == "ida"){
+        bench_ida();
+        ran = true;
+    }
+    if(all || bench_section == "cache"){
+        bench_cache(levels);
+        ran = true;
+    }
+    if(all || bench_section == "stats"){
+        bench_stats();
+        ran = true;
+    }
+    if(all || bench_section == "layout"){
+        bench_layout();
+        ran = true;
+    }
+    if(all || bench_section == "anytime"){
+        bench_anytime();
+        ran = true;
+    }
+    if(all || bench_section == "route"){
+        bench_route(levels);
+        ran = true;
+    }
+    if(all || bench_section == "grid"){
+        bench_grid();
+        ran = true;
+    }
+    if(all || bench_section == "verify"){
+        ok = bench_verify(levels, level_filename, baseline_filename);
+        ran = true;
+    }
+
+    if(!ran){
+        help_screen("Unknown benchmark '" + bench_section + "'.");
+        exit(1);
+    }
+    return ok;
+}
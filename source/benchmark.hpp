@@ -0,0 +1,100 @@
+#ifndef BENCHMARK_HPP
+#define BENCHMARK_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "level.hpp"
+#include "path_query.hpp"
+
+/**
+ * @brief Shared fixture of the --bench sections.
+ *
+ * Each section lives next to the module it measures, in
+ * `<module>_bench.cpp`, and is declared at the end of this file;
+ * MouzeSimulation::run_benchmarks (benchmark.cpp) picks them by name.
+ */
+
+using Clock = std::chrono::steady_clock;
+
+double elapsed_ms(Clock::time_point since);
+
+/**
+ * @brief A named board of a benchmark.
+ */
+
+struct BenchBoard {
+    std::string name;
+    Level level;
+};
+
+//níveis carregados (como "level N") e os labirintos com terreno gerados
+std::vector<BenchBoard> terrain_boards(const std::vector<Level>& levels);
+
+//células que não são parede, linha a linha
+std::vector<Point> open_cells(const Level& level);
+
+//custo do caminho (a posição da cabeça não faz parte dele)
+int path_cost(const Level& level, const std::vector<Point>& path);
+
+/**
+ * @brief Random open cells of a level, reproducible from a seed.
+ *
+ * Every draw is a uniform pick among open_cells(level); a query draws its
+ * start first and then its goal, so a seed always gives the same queries.
+ * Check `usable()` before drawing: a board needs two open cells.
+ */
+
+class QuerySampler {
+    public:
+        QuerySampler(const Level& level, unsigned seed)
+            : open(open_cells(level)), gen(seed), pick(0, open.empty() ? 0 : open.size() - 1) {}
+
+        bool usable() const { return open.size() >= 2; }
+        const std::vector<Point>& cells() const { return open; }
+        void seed(unsigned value){
+            gen.seed(value);
+            pick.reset();
+        }
+
+        Point cell(){ return open[pick(gen)]; }
+        PathQuery query(){
+            Point start = cell();
+            return {start, cell()};
+        }
+        std::vector<PathQuery> queries(size_t count){
+            std::vector<PathQuery> batch(count);
+            for(PathQuery& q : batch){
+                q = query();
+            }
+            return batch;
+        }
+
+    private:
+        std::vector<Point> open;
+        std::mt19937 gen;
+        std::uniform_int_distribution<size_t> pick;
+};
+
+//seções de --bench (ver MouzeSimulation::run_benchmarks)
+void bench_alt(const std::vector<Level>& levels);
+void bench_tour();
+void bench_alloc();
+void bench_rollout();
+void bench_grid();
+bool bench_verify(const std::vector<Level>& levels, const std::string& level_filename, const std::string& baseline_filename);
+void bench_parallel_astar();
+void bench_batch(const std::vector<Level>& levels);
+void bench_layout();
+void bench_route(const std::vector<Level>& levels);
+void bench_anytime();
+void bench_cpd(const std::vector<Level>& levels);
+void bench_stats();
+void bench_cache(const std::vector<Level>& levels);
+void bench_ida();
+void bench_distance_field();
+
+#endif
@@ -0,0 +1,82 @@
+#include "compact_path.hpp"
+
+#include <cstdlib>
+#include <utility>
+
+/**
+ * @brief Empties the path, keeping its buffer, and sets where it starts.
+ */
+
+void CompactPath::clear(Point start){
+    origin = start;
+    runs.clear();
+    steps = 0;
+}
+
+/**
+ * @brief Appends one move, extending the last run when it goes the same way.
+ */
+
+void CompactPath::push(Dir move){
+    if(!runs.empty() && (runs.back() & 3) == move && (runs.back() >> 2) < MAX_RUN - 1){
+        runs.back() += 4;
+    }else{
+        runs.push_back(static_cast<std::uint8_t>(move));
+    }
+    ++steps;
+}
+
+/**
+ * @brief Encodes a path given as cells, each one next to the previous.
+ *
+ * @param start Cell before the first one of `cells` (the head).
+ * @param cells Cells to walk, start excluded.
+ * @return False if two consecutive cells are not neighbours; the path then
+ * stops before the first of them.
+ */
+
+bool CompactPath::assign(Point start, const std::vector<Point>& cells){
+    clear(start);
+    Point from = start;
+    for(const Point& to : cells){
+        const int dx = to.x - from.x;
+        const int dy = to.y - from.y;
+        if(std::abs(dx) + std::abs(dy) != 1){
+            return false;
+        }
+        push(dx < 0 ? Dir::N : dx > 0 ? Dir::S : dy > 0 ? Dir::L : Dir::O);
+        from = to;
+    }
+    return true;
+}
+
+void CompactPath::swap(CompactPath& other){
+    std::swap(origin, other.origin);
+    runs.swap(other.runs);
+    std::swap(steps, other.steps);
+}
+
+/**
+ * @brief Bytes held by the path, buffer capacity included.
+ */
+
+size_t CompactPath::memory_bytes() const{
+    return sizeof(*this) + runs.capacity();
+}
+
+/**
+ * @brief Moves to the next cell of the path and returns it.
+ *
+ * Must not be called when done().
+ */
+
+Point CompactPath::Cursor::next(){
+    const std::uint8_t current = path->runs[run];
+    const Point& move = MOVES[current & 3];
+    position = {position.x + move.x, position.y + move.y};
+    if(++taken > (current >> 2)){
+        ++run;
+        taken = 0;
+    }
+    return position;
+}
@@ -0,0 +1,65 @@
+#ifndef COMPACT_PATH_HPP
+#define COMPACT_PATH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "direction.hpp"
+
+/**
+ * @brief Path stored as runs of moves from a start cell.
+ *
+ * Each byte is one run: the Dir in the two low bits and the run length
+ * minus one in the six high bits, so a straight stretch of up to MAX_RUN
+ * cells takes one byte instead of one Point (8 bytes) plus one Dir. The
+ * cells are rebuilt one at a time by a Cursor.
+ *
+ * Paths are handed between Player and MouzeSimulation with `swap`, so the
+ * buffers of both sides are reused and no path is copied on a replan.
+ */
+
+class CompactPath {
+    public:
+        static const int MAX_RUN = 64;
+
+        /**
+         * @brief Walks the cells of a path, start excluded.
+         *
+         * Invalidated when the path is changed.
+         */
+
+        class Cursor {
+            public:
+                Cursor() = default;
+                bool done() const { return path == nullptr || run >= path->runs.size(); }
+                Point next();
+
+            private:
+                friend class CompactPath;
+                Cursor(const CompactPath& p) : path(&p), position(p.origin) {}
+
+                const CompactPath* path = nullptr;
+                Point position{0, 0};
+                size_t run = 0;
+                int taken = 0; //passos já dados no trecho atual
+        };
+
+        void clear(Point start);
+        void push(Dir move);
+        bool assign(Point start, const std::vector<Point>& cells);
+        void swap(CompactPath& other);
+
+        Cursor begin() const { return Cursor(*this); }
+        Point start() const { return origin; }
+        size_t size() const { return steps; }
+        bool empty() const { return steps == 0; }
+        size_t memory_bytes() const;
+
+    private:
+        Point origin{0, 0};
+        std::vector<std::uint8_t> runs;
+        size_t steps = 0;
+};
+
+#endif
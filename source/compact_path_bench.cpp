@@ -0,0 +1,56 @@
+#include "benchmark.hpp"
+#include "compact_path.hpp"
+#include "player.hpp"
+
+#include <iomanip>
+#include <iostream>
+
+/**
+ * @brief Compares the memory of paths as cells and as CompactPath.
+ *
+ * "cells" is what a path took before: the Point vector plus one Dir per
+ * step. "handover" times take_route plus walking the path with a
+ * cursor, which is what the simulation does on every replan.
+ */
+
+void bench_route(const std::vector<Level>& levels){
+    const int pairs = 200;
+    std::cout << "\n[PATH STORAGE: CELLS x COMPACT PATH]\n";
+    std::cout << std::left << std::setw(18) << "board" << std::right << std::setw(10) << "steps"
+              << std::setw(12) << "cells B" << std::setw(12) << "compact B" << std::setw(9) << "ratio"
+              << std::setw(14) << "handover ns" << "\n";
+
+    for(const auto& [name, level] : terrain_boards(levels)){
+        QuerySampler sampler(level, 3);
+        if(!sampler.usable()) continue;
+
+        Player player(level);
+        CompactPath route;
+        size_t steps = 0, cell_bytes = 0, compact_bytes = 0, mismatches = 0;
+        double ms = 0;
+        for(int k=0;k<pairs;++k){
+            const PathQuery query = sampler.query();
+            player.computed_path_A(query.start, query.goal);
+            steps += player.path.size();
+            cell_bytes += player.path.size() * (sizeof(Point) + sizeof(Dir));
+
+            auto begin = Clock::now();
+            player.take_route(query.start, route);
+            size_t walked = 0;
+            for(CompactPath::Cursor step = route.begin(); !step.done(); ++walked){
+                mismatches += step.next() != player.path[walked];
+            }
+            ms += elapsed_ms(begin);
+            mismatches += walked != player.path.size();
+            compact_bytes += route.memory_bytes() - sizeof(route) + sizeof(Point);
+        }
+
+        std::cout << std::left << std::setw(18) << name << std::right << std::setw(10) << steps / pairs
+                  << std::setw(12) << cell_bytes / pairs << std::setw(12) << compact_bytes / pairs
+                  << std::setw(8) << std::fixed << std::setprecision(1) << (double)cell_bytes / compact_bytes << "x"
+                  << std::setw(14) << std::setprecision(0) << ms * 1e6 / pairs << "\n";
+        if(mismatches){
+            std::cout << "  ! " << mismatches << " cells differ from the A* path\n";
+        }
+    }
+}
@@ -0,0 +1,453 @@
+#include "corridor_graph.hpp"
+#include "level.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <functional>
+
+namespace {
+    const int INF = INT_MAX;
+}
+
+/**
+ * @brief Builds the junction graph of a level.
+ *
+ * Marks every passable cell whose passable degree is not two as a node,
+ * walks the corridors between nodes, lays the adjacency out in CSR form and
+ * fills the dead-end branches. Pure cycles without any junction get one of
+ * their cells promoted to a node. Must be called again whenever the walls of
+ * the level change (i.e. when a new level is loaded).
+ *
+ * @param level Level whose board is contracted.
+ */
+
+void CorridorGraph::build(const Level& level){
+    rows = level.rows;
+    cols = level.cols;
+    const int cells = rows * cols;
+
+    cell_cost.assign(cells, -1);
+    for(int i=0;i<rows;++i){
+        for(int j=0;j<cols;++j){
+            //linhas menores que cols são tratadas como parede
+            char c = j < (int)level.board[i].size() ? level.board[i][j] : '#';
+            if(c != '#'){
+                cell_cost[i * cols + j] = level.terrain_cost(c);
+            }
+        }
+    }
+
+    cell_node.assign(cells, -1);
+    cell_corridor.assign(cells, -1);
+    cell_offset.assign(cells, -1);
+    node_cell.clear();
+    corridor_first.assign(1, 0);
+    corridor_cells.clear();
+    corridor_prefix.clear();
+    corridor_from.clear();
+    corridor_to.clear();
+
+    //junções, becos e células isoladas viram nós
+    for(int idx=0;idx<cells;++idx){
+        if(cell_cost[idx] < 0) continue;
+        int degree = 0;
+        for(int d=0;d<4;++d){
+            if(neighbor(idx, d) != -1) ++degree;
+        }
+        if(degree != 2){
+            cell_node[idx] = node_cell.size();
+            node_cell.push_back(idx);
+        }
+    }
+
+    const int junctions = node_cell.size();
+    for(int n=0;n<junctions;++n){
+        trace_corridors(n);
+    }
+
+    //ciclos sem junção: promove uma célula qualquer a nó
+    for(int idx=0;idx<cells;++idx){
+        if(cell_cost[idx] >= 0 && cell_node[idx] == -1 && cell_corridor[idx] == -1){
+            cell_node[idx] = node_cell.size();
+            node_cell.push_back(idx);
+            trace_corridors(cell_node[idx]);
+        }
+    }
+
+    //monta a adjacência em CSR (duas meias-arestas por corredor)
+    const int nodes = node_cell.size();
+    const int corridors = corridor_from.size();
+    first_edge.assign(nodes + 1, 0);
+    for(int c=0;c<corridors;++c){
+        ++first_edge[corridor_from[c] + 1];
+        ++first_edge[corridor_to[c] + 1];
+    }
+    for(int n=0;n<nodes;++n){
+        first_edge[n + 1] += first_edge[n];
+    }
+
+    edge_target.assign(2 * corridors, 0);
+    edge_cost.assign(2 * corridors, 0);
+    edge_corridor.assign(2 * corridors, 0);
+    edge_forward.assign(2 * corridors, 0);
+    std::vector<int> cursor(first_edge.begin(), first_edge.end() - 1);
+
+    auto add_edge = [&](int from, int to, int cost, int corridor, bool forward){
+        int e = cursor[from]++;
+        edge_target[e] = to;
+        edge_cost[e] = cost;
+        edge_corridor[e] = corridor;
+        edge_forward[e] = forward;
+    };
+
+    for(int c=0;c<corridors;++c){
+        int length = corridor_first[c + 1] - corridor_first[c];
+        int inner = length > 0 ? interior_cost(c, 0, length - 1) : 0;
+        int a = corridor_from[c];
+        int b = corridor_to[c];
+        add_edge(a, b, inner + cell_cost[node_cell[b]], c, true);
+        add_edge(b, a, inner + cell_cost[node_cell[a]], c, false);
+    }
+
+    fill_dead_ends();
+}
+
+/**
+ * @brief Returns the index of the passable neighbor of a cell, or -1.
+ *
+ * @param idx Cell index (row * cols + col).
+ * @param d Direction index into MOVES.
+ */
+
+int CorridorGraph::neighbor(int idx, int d) const{
+    int x = idx / cols + MOVES[d].x;
+    int y = idx % cols + MOVES[d].y;
+    if(x < 0 || y < 0 || x >= rows || y >= cols) return -1;
+    int next = x * cols + y;
+    return cell_cost[next] >= 0 ? next : -1;
+}
+
+/**
+ * @brief Walks every corridor leaving a node that was not walked yet.
+ *
+ * Corridors are recorded once: a corridor with interior cells is skipped
+ * when its first cell already belongs to a corridor, and a direct link
+ * between two adjacent nodes is only recorded from the lower node id.
+ *
+ * @param node Node the corridors start from.
+ */
+
+void CorridorGraph::trace_corridors(int node){
+    const int start = node_cell[node];
+
+    for(int d=0;d<4;++d){
+        int cur = neighbor(start, d);
+        if(cur == -1) continue;
+        if(cell_node[cur] != -1 && cell_node[cur] < node) continue;
+        if(cell_node[cur] == -1 && cell_corridor[cur] != -1) continue;
+
+        const int c = corridor_from.size();
+        int prev = start;
+        int sum = 0;
+        while(cell_node[cur] == -1){
+            cell_corridor[cur] = c;
+            cell_offset[cur] = corridor_cells.size() - corridor_first[c];
+            sum += cell_cost[cur];
+            corridor_cells.push_back(cur);
+            corridor_prefix.push_back(sum);
+
+            //célula de corredor tem exatamente dois vizinhos: segue pelo que não é o anterior
+            int next = -1;
+            for(int k=0;k<4 && next == -1;++k){
+                int candidate = neighbor(cur, k);
+                if(candidate != -1 && candidate != prev){
+                    next = candidate;
+                }
+            }
+            prev = cur;
+            cur = next;
+        }
+        corridor_from.push_back(node);
+        corridor_to.push_back(cell_node[cur]);
+        corridor_first.push_back(corridor_cells.size());
+    }
+}
+
+/**
+ * @brief Marks tree-shaped branches of the graph as filled dead ends.
+ *
+ * Repeatedly removes nodes of degree one. Every removed node is tagged with
+ * the top of its branch (the removed node adjacent to the surviving part of
+ * the graph); surviving nodes are tagged with -1.
+ */
+
+void CorridorGraph::fill_dead_ends(){
+    const int nodes = node_cell.size();
+    std::vector<int> degree(nodes);
+    std::vector<int> parent(nodes, -1);
+    std::vector<char> filled(nodes, 0);
+    std::vector<int> leaves;
+    std::vector<int> order;
+
+    for(int n=0;n<nodes;++n){
+        degree[n] = first_edge[n + 1] - first_edge[n];
+        if(degree[n] == 1){
+            leaves.push_back(n);
+        }
+    }
+
+    while(!leaves.empty()){
+        int n = leaves.back();
+        leaves.pop_back();
+        if(filled[n] || degree[n] != 1) continue;
+
+        filled[n] = 1;
+        degree[n] = 0;
+        order.push_back(n);
+        for(int e=first_edge[n];e<first_edge[n + 1];++e){
+            int t = edge_target[e];
+            if(!filled[t]){
+                parent[n] = t;
+                if(--degree[t] == 1){
+                    leaves.push_back(t);
+                }
+                break;
+            }
+        }
+    }
+
+    //pais são removidos depois dos filhos, então percorre a ordem invertida
+    node_branch.assign(nodes, -1);
+    for(auto it = order.rbegin(); it != order.rend(); ++it){
+        int n = *it;
+        node_branch[n] = filled[parent[n]] ? node_branch[parent[n]] : n;
+    }
+}
+
+/**
+ * @brief Sums the terrain cost of the interior cells of a corridor.
+ *
+ * @param corridor Corridor id.
+ * @param from First offset (inclusive).
+ * @param to Last offset (inclusive); an empty range costs zero.
+ * @return Total cost of entering the cells in [from, to].
+ */
+
+int CorridorGraph::interior_cost(int corridor, int from, int to) const{
+    if(from > to) return 0;
+    int base = corridor_first[corridor];
+    return corridor_prefix[base + to] - (from > 0 ? corridor_prefix[base + from - 1] : 0);
+}
+
+/**
+ * @brief Appends interior cells of a corridor to a path.
+ *
+ * Cells are appended from offset `from` up or down to offset `to`, both
+ * inclusive.
+ */
+
+void CorridorGraph::append_cells(int corridor, int from, int to, std::vector<Point>& path) const{
+    int base = corridor_first[corridor];
+    int step = from <= to ? 1 : -1;
+    for(int k=from;;k+=step){
+        path.push_back(point(corridor_cells[base + k]));
+        if(k == to) break;
+    }
+}
+
+/**
+ * @brief Finds the cheapest path between two cells over the junction graph.
+ *
+ * Runs Dijkstra over the contracted nodes, entering start and goal at their
+ * position inside a corridor when they are not nodes themselves, and skips
+ * dead-end branches that contain neither of them. The resulting node chain
+ * is expanded back into grid cells.
+ *
+ * @param start Cell where the mouse is.
+ * @param goal Target cell.
+ * @param path Receives the cells from start (excluded) to goal (included).
+ * @param search Working memory, reused between queries.
+ * @return True if the goal is reachable.
+ */
+
+bool CorridorGraph::find_path(Point start, Point goal, std::vector<Point>& path, Search& search) const{
+    path.clear();
+    if(!is_passable(start) || !is_passable(goal)){
+        return false;
+    }
+    if(start == goal){
+        return true;
+    }
+
+    const int nodes = node_cell.size();
+    const int si = index(start);
+    const int gi = index(goal);
+    std::vector<int>& dist = search.dist;
+    std::vector<int>& parent_node = search.parent_node;
+    std::vector<int>& parent_edge = search.parent_edge;
+    std::vector<int>& seed_side = search.seed_side;
+    std::vector<std::pair<int, int>>& heap = search.heap;
+    std::vector<int>& chain = search.chain;
+    dist.assign(nodes, INF);
+    parent_node.assign(nodes, -1);
+    parent_edge.assign(nodes, -1);
+    seed_side.assign(nodes, -1);
+    heap.clear();
+
+    auto branch_of = [&](int idx){
+        if(cell_node[idx] != -1) return node_branch[cell_node[idx]];
+        int c = cell_corridor[idx];
+        int b = node_branch[corridor_from[c]];
+        return b != -1 ? b : node_branch[corridor_to[c]];
+    };
+    const int start_branch = branch_of(si);
+    const int goal_branch = branch_of(gi);
+
+    auto allowed = [&](int n){
+        int b = node_branch[n];
+        return b == -1 || b == start_branch || b == goal_branch;
+    };
+
+    auto push = [&](int d, int n){
+        heap.push_back({d, n});
+        std::push_heap(heap.begin(), heap.end(), std::greater<>());
+    };
+
+    int best = INF;
+    int best_node = -1; //-1 com best finito: caminho direto dentro do corredor
+    int best_side = -1;
+
+    const int sc = cell_corridor[si];
+    const int sk = cell_offset[si];
+    const int gc = cell_corridor[gi];
+    const int gk = cell_offset[gi];
+
+    //pontos de entrada no grafo a partir do início
+    if(cell_node[si] != -1){
+        dist[cell_node[si]] = 0;
+        seed_side[cell_node[si]] = 2;
+        push(0, cell_node[si]);
+    }else{
+        int length = corridor_first[sc + 1] - corridor_first[sc];
+        int a = corridor_from[sc];
+        int b = corridor_to[sc];
+        int to_a = interior_cost(sc, 0, sk - 1) + cell_cost[node_cell[a]];
+        int to_b = interior_cost(sc, sk + 1, length - 1) + cell_cost[node_cell[b]];
+        dist[a] = to_a;
+        seed_side[a] = 0;
+        if(to_b < dist[b]){
+            dist[b] = to_b;
+            seed_side[b] = 1;
+        }
+        push(dist[a], a);
+        if(b != a) push(dist[b], b);
+
+        if(gc == sc){
+            best = gk > sk ? interior_cost(sc, sk + 1, gk) : interior_cost(sc, gk, sk - 1);
+        }
+    }
+
+    while(!heap.empty()){
+        std::pop_heap(heap.begin(), heap.end(), std::greater<>());
+        auto [d, n] = heap.back();
+        heap.pop_back();
+
+        if(d > dist[n]) continue;
+        if(d >= best) break;
+
+        if(node_cell[n] == gi){
+            best = d;
+            best_node = n;
+            break;
+        }
+        if(gc != -1){
+            int glength = corridor_first[gc + 1] - corridor_first[gc];
+            if(n == corridor_from[gc] && d + interior_cost(gc, 0, gk) < best){
+                best = d + interior_cost(gc, 0, gk);
+                best_node = n;
+                best_side = 0;
+            }
+            if(n == corridor_to[gc] && d + interior_cost(gc, gk, glength - 1) < best){
+                best = d + interior_cost(gc, gk, glength - 1);
+                best_node = n;
+                best_side = 1;
+            }
+        }
+
+        for(int e=first_edge[n];e<first_edge[n + 1];++e){
+            int t = edge_target[e];
+            if(!allowed(t)) continue;
+            int nd = d + edge_cost[e];
+            if(nd < dist[t]){
+                dist[t] = nd;
+                parent_node[t] = n;
+                parent_edge[t] = e;
+                seed_side[t] = -1;
+                push(nd, t);
+            }
+        }
+    }
+
+    if(best == INF){
+        return false;
+    }
+
+    if(best_node == -1){
+        append_cells(sc, gk > sk ? sk + 1 : sk - 1, gk, path);
+        return true;
+    }
+
+    //cadeia de arestas do nó semente até o último nó
+    chain.clear();
+    int seed = best_node;
+    while(parent_edge[seed] != -1){
+        chain.push_back(parent_edge[seed]);
+        seed = parent_node[seed];
+    }
+    std::reverse(chain.begin(), chain.end());
+
+    if(seed_side[seed] != 2){
+        int length = corridor_first[sc + 1] - corridor_first[sc];
+        if(seed_side[seed] == 0 && sk > 0){
+            append_cells(sc, sk - 1, 0, path);
+        }else if(seed_side[seed] == 1 && sk < length - 1){
+            append_cells(sc, sk + 1, length - 1, path);
+        }
+        path.push_back(point(node_cell[seed]));
+    }
+
+    for(int e : chain){
+        int c = edge_corridor[e];
+        int length = corridor_first[c + 1] - corridor_first[c];
+        if(length > 0){
+            if(edge_forward[e]){
+                append_cells(c, 0, length - 1, path);
+            }else{
+                append_cells(c, length - 1, 0, path);
+            }
+        }
+        path.push_back(point(node_cell[edge_target[e]]));
+    }
+
+    if(best_side != -1){
+        int glength = corridor_first[gc + 1] - corridor_first[gc];
+        append_cells(gc, best_side == 0 ? 0 : glength - 1, gk, path);
+    }
+    return true;
+}
+
+/**
+ * @brief Checks whether a cell is inside the board and not a wall.
+ */
+
+bool CorridorGraph::is_passable(Point p) const{
+    return p.x >= 0 && p.y >= 0 && p.x < rows && p.y < cols && cell_cost[index(p)] >= 0;
+}
+
+size_t CorridorGraph::node_count() const{
+    return node_cell.size();
+}
+
+size_t CorridorGraph::corridor_count() const{
+    return corridor_from.size();
+}
@@ -0,0 +1,86 @@
+#ifndef CORRIDOR_GRAPH_HPP
+#define CORRIDOR_GRAPH_HPP
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "direction.hpp"
+
+class Level;
+
+/**
+ * @brief Junction graph of a level, built by contracting 1-wide corridors.
+ *
+ * Every passable cell with a number of passable neighbors other than two
+ * becomes a node; the chains of two-neighbor cells between nodes become
+ * weighted edges (corridors). Adjacency is stored in CSR form
+ * (`first_edge`/`edge_target`/...), and the interior cells of each corridor
+ * are kept in a flat array so a path over the graph can be expanded back
+ * into grid cells.
+ *
+ * Tree-shaped branches (dead ends) are filled during the build, so a query
+ * only enters a branch when the start or the goal is inside it.
+ */
+
+class CorridorGraph {
+    public:
+        /**
+         * @brief Working memory of find_path, kept by the caller so one
+         * graph can serve several searchers.
+         */
+
+        struct Search {
+            std::vector<int> dist;
+            std::vector<int> parent_node;
+            std::vector<int> parent_edge;
+            std::vector<int> seed_side;
+            std::vector<std::pair<int, int>> heap;
+            std::vector<int> chain;
+        };
+
+        void build(const Level& level);
+        bool find_path(Point start, Point goal, std::vector<Point>& path, Search& search) const;
+
+        size_t node_count() const;
+        size_t corridor_count() const;
+        bool is_passable(Point p) const;
+
+    private:
+        int rows = 0;
+        int cols = 0;
+
+        //dados por célula
+        std::vector<int> cell_cost;
+        std::vector<int> cell_node;
+        std::vector<int> cell_corridor;
+        std::vector<int> cell_offset;
+
+        //CSR: arestas de saída do nó n em [first_edge[n], first_edge[n+1])
+        std::vector<int> node_cell;
+        std::vector<int> first_edge;
+        std::vector<int> edge_target;
+        std::vector<int> edge_cost;
+        std::vector<int> edge_corridor;
+        std::vector<char> edge_forward;
+
+        //corredores: células internas em [corridor_first[c], corridor_first[c+1])
+        std::vector<int> corridor_first;
+        std::vector<int> corridor_cells;
+        std::vector<int> corridor_prefix;
+        std::vector<int> corridor_from;
+        std::vector<int> corridor_to;
+
+        //preenchimento de becos: ramo (ou -1) de cada nó
+        std::vector<int> node_branch;
+
+        int index(Point p) const { return p.x * cols + p.y; }
+        Point point(int idx) const { return {idx / cols, idx % cols}; }
+        int neighbor(int idx, int d) const;
+        int interior_cost(int corridor, int from, int to) const;
+        void trace_corridors(int node);
+        void fill_dead_ends();
+        void append_cells(int corridor, int from, int to, std::vector<Point>& path) const;
+};
+
+#endif
@@ -0,0 +1,345 @@
+#include "distance_field.hpp"
+#include "level.hpp"
+#include "search.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <thread>
+
+namespace {
+    const size_t CHUNK = 256; //células tiradas do contador de cada vez
+    const int SPINS_BEFORE_YIELD = 64;
+
+    /**
+     * @brief Reusable barrier for a fixed number of threads.
+     *
+     * Spins on a generation counter, yielding the core after a few tries so
+     * it also works with more threads than cores.
+     */
+
+    class SpinBarrier {
+        public:
+            explicit SpinBarrier(unsigned count) : total(count) {}
+
+            void wait(){
+                const unsigned generation = passed.load(std::memory_order_acquire);
+                if(arrived.fetch_add(1, std::memory_order_acq_rel) + 1 == total){
+                    arrived.store(0, std::memory_order_relaxed);
+                    passed.fetch_add(1, std::memory_order_release);
+                    return;
+                }
+                for(int spins = 0; passed.load(std::memory_order_acquire) == generation; ++spins){
+                    if(spins >= SPINS_BEFORE_YIELD){
+                        std::this_thread::yield();
+                    }
+                }
+            }
+
+        private:
+            const unsigned total;
+            alignas(64) std::atomic<unsigned> arrived{0};
+            alignas(64) std::atomic<unsigned> passed{0};
+    };
+
+    struct Item {
+        int cell;
+        int d; //distância quando entrou no balde (se mudou, o item está velho)
+    };
+
+    /**
+     * @brief Lists and counters of one thread; only that thread writes them.
+     */
+
+    struct alignas(64) Worker {
+        std::vector<int> next[2]; //BFS: fronteira da rodada par e da ímpar
+        std::vector<Item> frontier[2]; //delta-stepping: idem
+        std::vector<std::vector<Item>> buckets; //circulares
+        std::vector<Item> settled; //tirados do balde atual, para as arestas pesadas
+        std::vector<size_t> offsets; //primeiro pedaço de cada lista na rodada
+        size_t updates = 0;
+        size_t rounds = 0;
+        size_t bucket_count = 0;
+        int max_cost = 0;
+        long next_bucket = -1;
+    };
+
+    /**
+     * @brief State shared by the threads of one search.
+     *
+     * `cost` is the terrain cost of entering each cell, 0 for walls, so
+     * the inner loops never look at the board.
+     */
+
+    struct Field {
+        const Level& level;
+        const int rows;
+        const int cols;
+        const unsigned threads;
+        std::unique_ptr<std::atomic<int>[]> dist;
+        std::unique_ptr<unsigned char[]> cost;
+        std::vector<Worker> workers;
+        SpinBarrier barrier;
+        std::atomic<size_t> claimed[2];
+
+        Field(const Level& lvl, unsigned thread_count)
+            : level(lvl), rows(lvl.rows), cols(lvl.cols), threads(thread_count),
+              dist(new std::atomic<int>[(size_t)lvl.rows * lvl.cols]),
+              cost(new unsigned char[(size_t)lvl.rows * lvl.cols]),
+              workers(thread_count), barrier(thread_count) {
+            claimed[0].store(0);
+            claimed[1].store(0);
+        }
+
+        int first_row(unsigned id) const { return (int)((long)rows * id / threads); }
+
+        //cada thread prepara e devolve as suas linhas
+        void prepare(unsigned id){
+            Worker& self = workers[id];
+            for(int x = first_row(id); x < first_row(id + 1); ++x){
+                for(int y=0;y<cols;++y){
+                    const size_t idx = (size_t)x * cols + y;
+                    dist[idx].store(UNREACHABLE, std::memory_order_relaxed);
+                    cost[idx] = is_open_cell(level, x, y) ? (unsigned char)level.terrain_cost(level.board[x][y]) : 0;
+                    self.max_cost = std::max<int>(self.max_cost, cost[idx]);
+                }
+            }
+        }
+
+        void publish(unsigned id, std::vector<int>& out) const {
+            const size_t begin = (size_t)first_row(id) * cols;
+            const size_t end = (size_t)first_row(id + 1) * cols;
+            for(size_t idx = begin; idx < end; ++idx){
+                out[idx] = dist[idx].load(std::memory_order_relaxed);
+            }
+        }
+
+        template<class Visit>
+        void for_each_neighbor(int idx, Visit visit) const {
+            const int x = idx / cols;
+            const int y = idx - x * cols;
+            if(x > 0 && cost[idx - cols]) visit(idx - cols);
+            if(x + 1 < rows && cost[idx + cols]) visit(idx + cols);
+            if(y > 0 && cost[idx - 1]) visit(idx - 1);
+            if(y + 1 < cols && cost[idx + 1]) visit(idx + 1);
+        }
+
+        /**
+         * @brief Visits every element of the lists `list(0..threads-1)`,
+         * split in chunks among the threads that call it.
+         *
+         * The lists must not change until every caller has passed the next
+         * barrier.
+         */
+
+        template<class List, class Visit>
+        void share(unsigned id, std::atomic<size_t>& counter, List list, Visit visit){
+            std::vector<size_t>& offsets = workers[id].offsets;
+            offsets.assign(threads + 1, 0);
+            for(unsigned t=0;t<threads;++t){
+                offsets[t + 1] = offsets[t] + (list(t).size() + CHUNK - 1) / CHUNK;
+            }
+            for(size_t chunk = counter.fetch_add(1, std::memory_order_relaxed); chunk < offsets[threads];
+                chunk = counter.fetch_add(1, std::memory_order_relaxed)){
+                const unsigned t = (unsigned)(std::upper_bound(offsets.begin(), offsets.end(), chunk) - offsets.begin() - 1);
+                const auto& items = list(t);
+                const size_t begin = (chunk - offsets[t]) * CHUNK;
+                const size_t end = std::min(begin + CHUNK, items.size());
+                for(size_t i = begin; i < end; ++i){
+                    visit(items[i]);
+                }
+            }
+        }
+    };
+
+    //baixa a distância se `value` for menor; verdadeiro se baixou
+    bool lower(std::atomic<int>& slot, int value){
+        int old = slot.load(std::memory_order_relaxed);
+        while(value < old){
+            if(slot.compare_exchange_weak(old, value, std::memory_order_relaxed)){
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void bfs_worker(Field& field, unsigned id, int source, std::vector<int>& out){
+        Worker& self = field.workers[id];
+        field.prepare(id);
+        field.barrier.wait();
+        if(id == 0){
+            field.dist[source].store(0, std::memory_order_relaxed);
+            self.next[0].push_back(source);
+        }
+        field.barrier.wait();
+
+        for(int depth = 0; ; ++depth){
+            const int now = depth & 1;
+            //a lista de saída foi lida na rodada anterior, já terminada
+            self.next[now ^ 1].clear();
+            if(id == 0){
+                field.claimed[now ^ 1].store(0, std::memory_order_relaxed);
+            }
+            field.share(id, field.claimed[now], [&](unsigned t) -> const std::vector<int>& { return field.workers[t].next[now]; },
+                [&](int cell){
+                    field.for_each_neighbor(cell, [&](int next){
+                        int expected = UNREACHABLE;
+                        if(field.dist[next].load(std::memory_order_relaxed) == UNREACHABLE
+                           && field.dist[next].compare_exchange_strong(expected, depth + 1, std::memory_order_relaxed)){
+                            self.next[now ^ 1].push_back(next);
+                            ++self.updates;
+                        }
+                    });
+                });
+            ++self.rounds;
+            field.barrier.wait();
+
+            size_t total = 0;
+            for(const Worker& worker : field.workers){
+                total += worker.next[now ^ 1].size();
+            }
+            if(total == 0) break;
+        }
+        field.publish(id, out);
+    }
+
+    void delta_worker(Field& field, unsigned id, int source, int delta, std::vector<int>& out){
+        Worker& self = field.workers[id];
+        field.prepare(id);
+        field.barrier.wait();
+
+        //um item fica no máximo max_cost acima do balde atual
+        int max_cost = 1;
+        for(const Worker& worker : field.workers){
+            max_cost = std::max(max_cost, worker.max_cost);
+        }
+        const long slots = max_cost / delta + 2;
+        self.buckets.assign(slots, {});
+        if(id == 0){
+            field.dist[source].store(0, std::memory_order_relaxed);
+            self.frontier[0].push_back({source, 0});
+        }
+        long bucket = 0;
+        int phase = 0;
+        self.bucket_count = 1;
+        field.barrier.wait();
+
+        auto relax = [&](const Item& item, bool light){
+            field.for_each_neighbor(item.cell, [&](int next){
+                const int step = field.cost[next];
+                if((step <= delta) != light) return;
+                const int d = item.d + step;
+                if(lower(field.dist[next], d)){
+                    self.buckets[(d / delta) % slots].push_back({next, d});
+                    ++self.updates;
+                }
+            });
+        };
+
+        while(true){
+            //rodada: arestas leves das células do balde atual
+            const int now = phase & 1;
+            self.frontier[now ^ 1].clear();
+            if(id == 0){
+                field.claimed[now ^ 1].store(0, std::memory_order_relaxed);
+            }
+            field.share(id, field.claimed[now], [&](unsigned t) -> const std::vector<Item>& { return field.workers[t].frontier[now]; },
+                [&](const Item& item){
+                    if(field.dist[item.cell].load(std::memory_order_relaxed) != item.d) return;
+                    self.settled.push_back(item);
+                    relax(item, true);
+                });
+            //o que voltou ao balde atual vira a fronteira da próxima rodada
+            std::swap(self.frontier[now ^ 1], self.buckets[bucket % slots]);
+            ++phase;
+            ++self.rounds;
+            field.barrier.wait();
+
+            size_t total = 0;
+            for(const Worker& worker : field.workers){
+                total += worker.frontier[phase & 1].size();
+            }
+            if(total > 0) continue;
+
+            //balde vazio: as distâncias dele são finais; arestas pesadas
+            for(const Item& item : self.settled){
+                if(field.dist[item.cell].load(std::memory_order_relaxed) == item.d){
+                    relax(item, false);
+                }
+            }
+            self.settled.clear();
+            self.next_bucket = -1;
+            for(long j = bucket + 1; j < bucket + slots; ++j){
+                if(!self.buckets[j % slots].empty()){
+                    self.next_bucket = j;
+                    break;
+                }
+            }
+            field.barrier.wait();
+
+            long next = -1;
+            for(const Worker& worker : field.workers){
+                if(worker.next_bucket >= 0 && (next < 0 || worker.next_bucket < next)){
+                    next = worker.next_bucket;
+                }
+            }
+            if(next < 0) break;
+            bucket = next;
+            ++self.bucket_count;
+            std::swap(self.frontier[phase & 1], self.buckets[bucket % slots]);
+            field.barrier.wait();
+        }
+        field.publish(id, out);
+    }
+
+    //a origem já foi verificada: é uma célula aberta
+    template<class Body>
+    DistanceFieldStats run_field(const Level& level, Point source, std::vector<int>& dist, unsigned threads, Body body){
+        if(threads == 0){
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        threads = std::min<unsigned>(threads, level.rows); //cada thread prepara ao menos uma linha
+        dist.resize((size_t)level.rows * level.cols);
+
+        Field field(level, threads);
+        const int start = source.x * level.cols + source.y;
+
+        std::vector<std::thread> pool;
+        for(unsigned t=1;t<threads;++t){
+            pool.emplace_back([&, t]{ body(field, t, start); });
+        }
+        body(field, 0, start);
+        for(auto& thread : pool){
+            thread.join();
+        }
+
+        DistanceFieldStats stats;
+        stats.rounds = field.workers[0].rounds;
+        stats.buckets = field.workers[0].bucket_count;
+        for(const Worker& worker : field.workers){
+            stats.updates += worker.updates;
+        }
+        return stats;
+    }
+}
+
+DistanceFieldStats parallel_bfs(const Level& level, Point source, std::vector<int>& dist, unsigned threads){
+    if(!is_open_cell(level, source.x, source.y)){
+        dist.assign((size_t)std::max(level.rows, 0) * std::max(level.cols, 0), UNREACHABLE);
+        return {};
+    }
+    return run_field(level, source, dist, threads, [&](Field& field, unsigned id, int start){
+        bfs_worker(field, id, start, dist);
+    });
+}
+
+DistanceFieldStats parallel_dijkstra(const Level& level, Point source, std::vector<int>& dist, unsigned threads, int delta){
+    if(!is_open_cell(level, source.x, source.y)){
+        dist.assign((size_t)std::max(level.rows, 0) * std::max(level.cols, 0), UNREACHABLE);
+        return {};
+    }
+    delta = std::max(delta, 1);
+    return run_field(level, source, dist, threads, [&](Field& field, unsigned id, int start){
+        delta_worker(field, id, start, delta, dist);
+    });
+}
@@ -0,0 +1,69 @@
+#ifndef DISTANCE_FIELD_HPP
+#define DISTANCE_FIELD_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include "direction.hpp"
+
+class Level;
+
+/**
+ * @brief Counters of one parallel distance field.
+ */
+
+struct DistanceFieldStats {
+    size_t rounds = 0; //rodadas entre duas barreiras (níveis da BFS, fases do delta-stepping)
+    size_t buckets = 0; //baldes do delta-stepping visitados (0 na BFS)
+    size_t updates = 0; //distâncias baixadas
+};
+
+/**
+ * @brief Level-synchronous parallel BFS over the whole board.
+ *
+ * Each round the frontier (the cells at the current depth) is cut into
+ * chunks that the threads take from a shared counter; a neighbor is
+ * claimed with a compare-and-swap on its distance, so every cell enters
+ * the next frontier exactly once. The next frontier is kept in one list
+ * per thread and read in place by every thread on the next round.
+ *
+ * Every move costs 1 here (steps, not terrain); see parallel_dijkstra for
+ * terrain costs. Cells are indexed as x * cols + y, as in dijkstra().
+ *
+ * @param level Level to search.
+ * @param source Cell where the search starts.
+ * @param dist Receives rows * cols step counts (UNREACHABLE when not
+ * reached). Its memory is reused when it already has that size.
+ * @param threads Number of threads; 0 uses every hardware thread.
+ * @return Counters of the search.
+ */
+
+DistanceFieldStats parallel_bfs(const Level& level, Point source, std::vector<int>& dist, unsigned threads);
+
+/**
+ * @brief Parallel delta-stepping Dijkstra over the whole board.
+ *
+ * Tentative distances live in buckets of width `delta`. The lowest
+ * non-empty bucket is emptied in rounds: its cells are split among the
+ * threads, which relax the light edges (terrain cost <= delta) with an
+ * atomic minimum on the distance and put improved cells back into the
+ * buckets. Once the bucket stays empty it is final, and every thread
+ * relaxes the heavy edges of the cells it settled there. A large delta
+ * means fewer rounds but more cells relaxed again; delta = 1 is a
+ * parallel Dial's algorithm.
+ *
+ * Moving into a cell costs Level::terrain_cost of that cell (the same cost
+ * as Player::get_terrain_cost), so `dist` matches dijkstra().
+ *
+ * @param level Level to search.
+ * @param source Cell where the search starts.
+ * @param dist Receives rows * cols distances (UNREACHABLE when not
+ * reached). Its memory is reused when it already has that size.
+ * @param threads Number of threads; 0 uses every hardware thread.
+ * @param delta Width of a bucket (at least 1).
+ * @return Counters of the search.
+ */
+
+DistanceFieldStats parallel_dijkstra(const Level& level, Point source, std::vector<int>& dist, unsigned threads, int delta = 5);
+
+#endif
@@ -0,0 +1,92 @@
+#include "benchmark.hpp"
+#include "distance_field.hpp"
+#include "maze.hpp"
+#include "search.hpp"
+
+#include <iomanip>
+#include <iostream>
+#include <queue>
+#include <string>
+
+/**
+ * @brief Whole-board distance fields: parallel BFS and delta-stepping
+ * Dijkstra against the sequential ones.
+ *
+ * The open board (most inner walls removed) has short, wide frontiers;
+ * the maze has long, thin ones, where a level-synchronous search spends
+ * its rounds on barriers. Distances must match the sequential search;
+ * speedup is relative to it.
+ */
+
+void bench_distance_field(){
+    std::cout << "\n[PARALLEL DISTANCE FIELDS]\n";
+    std::cout << std::left << std::setw(22) << "board" << std::setw(10) << "search" << std::right << std::setw(9) << "threads"
+              << std::setw(11) << "ms" << std::setw(10) << "speedup" << std::setw(10) << "rounds" << std::setw(12) << "updates" << "\n";
+
+    std::vector<BenchBoard> boards;
+    boards.push_back({"open 4001x4001 t30", generate_maze(4001, 4001, 21, 70, 30)});
+    boards.push_back({"maze 1001x1001 t30", generate_maze(1001, 1001, 22, 10, 30)});
+
+    for(const BenchBoard& board : boards){
+        const Level& level = board.level;
+        const Point source = level.start_mouse;
+        std::vector<int> expected;
+        std::vector<int> dist;
+
+        //BFS sequencial de referência: passos, sem terreno
+        auto begin = Clock::now();
+        expected.assign((size_t)level.rows * level.cols, UNREACHABLE);
+        std::queue<Point> open;
+        expected[source.x * level.cols + source.y] = 0;
+        open.push(source);
+        while(!open.empty()){
+            const Point cell = open.front();
+            open.pop();
+            const int d = expected[cell.x * level.cols + cell.y];
+            for(const Point& move : MOVES){
+                const int nx = cell.x + move.x;
+                const int ny = cell.y + move.y;
+                if(!is_open_cell(level, nx, ny) || expected[nx * level.cols + ny] != UNREACHABLE) continue;
+                expected[nx * level.cols + ny] = d + 1;
+                open.push({nx, ny});
+            }
+        }
+        double sequential_ms = elapsed_ms(begin);
+
+        auto report = [&](const char* search, const char* threads, double ms, const DistanceFieldStats* stats){
+            std::cout << std::left << std::setw(22) << board.name << std::setw(10) << search << std::right << std::setw(9) << threads
+                      << std::fixed << std::setprecision(1) << std::setw(11) << ms << std::setw(10) << std::setprecision(2) << sequential_ms / ms
+                      << std::setprecision(1);
+            if(stats){
+                std::cout << std::setw(10) << stats->rounds << std::setw(12) << stats->updates << "\n";
+            }else{
+                std::cout << std::setw(10) << "-" << std::setw(12) << "-" << "\n";
+            }
+        };
+
+        report("BFS", "seq", sequential_ms, nullptr);
+        for(unsigned threads : {1u, 2u, 4u, 8u, 16u}){
+            begin = Clock::now();
+            DistanceFieldStats stats = parallel_bfs(level, source, dist, threads);
+            double ms = elapsed_ms(begin);
+            report("BFS", std::to_string(threads).c_str(), ms, &stats);
+            if(dist != expected){
+                std::cout << "  ! distances differ from the sequential BFS\n";
+            }
+        }
+
+        begin = Clock::now();
+        dijkstra(level, source, expected);
+        sequential_ms = elapsed_ms(begin);
+        report("Dijkstra", "seq", sequential_ms, nullptr);
+        for(unsigned threads : {1u, 2u, 4u, 8u, 16u}){
+            begin = Clock::now();
+            DistanceFieldStats stats = parallel_dijkstra(level, source, dist, threads);
+            double ms = elapsed_ms(begin);
+            report("delta", std::to_string(threads).c_str(), ms, &stats);
+            if(dist != expected){
+                std::cout << "  ! distances differ from dijkstra()\n";
+            }
+        }
+    }
+}
@@ -0,0 +1,222 @@
+#include "embedded_levels.hpp"
+
+#ifdef MOUZE_EMBEDDED_LEVELS
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <string_view>
+
+namespace {
+    constexpr std::string_view PACK =
+#include "embedded_levels.inc"
+    ;
+
+    constexpr bool is_space(char c){
+        return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+    }
+
+    constexpr bool is_allowed(char c){
+        return c == '#' || c == '@' || c == '%' || c == '&' || c == ' ' || c == '.';
+    }
+
+    //lê um inteiro como `operator>>`: pula espaços e aceita sinal
+    constexpr bool read_int(size_t& pos, int& value){
+        while(pos < PACK.size() && is_space(PACK[pos])) ++pos;
+        bool negative = false;
+        if(pos < PACK.size() && (PACK[pos] == '-' || PACK[pos] == '+')){
+            negative = PACK[pos] == '-';
+            ++pos;
+        }
+        if(pos >= PACK.size() || PACK[pos] < '0' || PACK[pos] > '9'){
+            return false;
+        }
+        long number = 0;
+        while(pos < PACK.size() && PACK[pos] >= '0' && PACK[pos] <= '9'){
+            number = std::min(number * 10 + (PACK[pos] - '0'), 1000000000L);
+            ++pos;
+        }
+        value = negative ? -number : number;
+        return true;
+    }
+
+    constexpr size_t line_end(size_t pos){
+        while(pos < PACK.size() && PACK[pos] != '\n') ++pos;
+        return pos;
+    }
+
+    constexpr size_t next_line(size_t pos){
+        pos = line_end(pos);
+        return pos < PACK.size() ? pos + 1 : pos;
+    }
+
+    /**
+     * @brief One level of the pack, read with the same rules as scan_level
+     * and validate_level.
+     */
+
+    struct LevelScan {
+        bool end = false;
+        bool bad_dimensions = false;
+        bool valid = false;
+        int rows = 0;
+        int cols = 0;
+        size_t first_line = 0; //posição da primeira linha do tabuleiro
+        size_t next = 0; //posição do próximo nível
+        size_t terrain = 0; //células '@' e '%' dentro da largura do nível
+    };
+
+    constexpr LevelScan scan(size_t pos){
+        LevelScan level;
+        if(!read_int(pos, level.rows) || !read_int(pos, level.cols)){
+            level.end = true;
+            return level;
+        }
+        if(level.rows <= 0 || level.cols <= 0 || level.rows > 100 || level.cols > 100){
+            level.bad_dimensions = true;
+            return level;
+        }
+
+        pos = next_line(pos);
+        level.first_line = pos;
+        int spawn_points = 0;
+        bool allowed = true;
+        for(int i=0;i<level.rows;++i){
+            const size_t end = line_end(pos);
+            for(size_t j=pos;j<end;++j){
+                const char c = PACK[j];
+                allowed = allowed && is_allowed(c);
+                if(c == '&') ++spawn_points;
+                if((c == '@' || c == '%') && (int)(j - pos) < level.cols) ++level.terrain;
+            }
+            pos = next_line(pos);
+        }
+        level.valid = allowed && spawn_points == 1;
+        level.next = pos;
+        return level;
+    }
+
+    struct PackSummary {
+        size_t levels = 0;
+        size_t lines = 0;
+        size_t terrain = 0;
+        bool bad_dimensions = false;
+    };
+
+    constexpr PackSummary summarize(){
+        PackSummary summary;
+        for(LevelScan level = scan(0); !level.end; level = scan(level.next)){
+            if(level.bad_dimensions){
+                summary.bad_dimensions = true;
+                break;
+            }
+            if(level.valid){
+                ++summary.levels;
+                summary.lines += level.rows;
+                summary.terrain += level.terrain;
+            }
+        }
+        return summary;
+    }
+
+    constexpr PackSummary SUMMARY = summarize();
+    static_assert(!SUMMARY.bad_dimensions, "embedded_levels.inc has a level with invalid dimensions");
+    static_assert(SUMMARY.levels > 0, "embedded_levels.inc has no valid level");
+
+    struct EmbeddedLevel {
+        int rows = 0;
+        int cols = 0;
+        size_t first_line = 0; //índice em Pack::lines
+        Point start{0, 0};
+        size_t terrain_begin = 0; //intervalo em Pack::terrain
+        size_t terrain_end = 0;
+    };
+
+    struct LineRef {
+        size_t offset = 0;
+        size_t length = 0;
+    };
+
+    struct TerrainCell {
+        Point cell{0, 0};
+        char kind = ' ';
+    };
+
+    struct Pack {
+        std::array<EmbeddedLevel, SUMMARY.levels> levels{};
+        std::array<LineRef, SUMMARY.lines> lines{};
+        std::array<TerrainCell, SUMMARY.terrain> terrain{};
+    };
+
+    /**
+     * @brief Resolves the valid levels of the pack, like find_start_position.
+     */
+
+    constexpr Pack build(){
+        Pack pack;
+        size_t level_count = 0;
+        size_t line_count = 0;
+        size_t terrain_count = 0;
+
+        for(LevelScan scanned = scan(0); !scanned.end && !scanned.bad_dimensions; scanned = scan(scanned.next)){
+            if(!scanned.valid) continue;
+
+            EmbeddedLevel& level = pack.levels[level_count++];
+            level.rows = scanned.rows;
+            level.cols = scanned.cols;
+            level.first_line = line_count;
+            level.terrain_begin = terrain_count;
+
+            size_t pos = scanned.first_line;
+            for(int i=0;i<scanned.rows;++i){
+                const size_t end = line_end(pos);
+                pack.lines[line_count++] = {pos, end - pos};
+                for(int j=0;j<scanned.cols && pos + j < end;++j){
+                    const char c = PACK[pos + j];
+                    if(c == '&'){
+                        level.start = {i, j};
+                    }else if(c == '@' || c == '%'){
+                        pack.terrain[terrain_count++] = {{i, j}, c};
+                    }
+                }
+                pos = next_line(pos);
+            }
+            level.terrain_end = terrain_count;
+        }
+        return pack;
+    }
+
+    constexpr Pack EMBEDDED = build();
+}
+
+/**
+ * @brief Copies the embedded levels into Level objects.
+ *
+ * Nothing is read from disk nor parsed: boards, start positions and
+ * terrain cells come from tables computed at compile time.
+ */
+
+std::vector<Level> embedded_levels(){
+    std::vector<Level> levels(EMBEDDED.levels.size());
+    for(size_t k=0;k<levels.size();++k){
+        const EmbeddedLevel& embedded = EMBEDDED.levels[k];
+        Level& level = levels[k];
+        level.rows = embedded.rows;
+        level.cols = embedded.cols;
+        level.board.resize(embedded.rows);
+        for(int i=0;i<embedded.rows;++i){
+            const LineRef& line = EMBEDDED.lines[embedded.first_line + i];
+            level.board.set_row(i, PACK.substr(line.offset, line.length));
+        }
+        level.board.compact();
+
+        level.start_mouse = embedded.start;
+        for(size_t t=embedded.terrain_begin;t<embedded.terrain_end;++t){
+            const TerrainCell& terrain = EMBEDDED.terrain[t];
+            (terrain.kind == '@' ? level.high_dificulty : level.medium_dificulty).push_back(terrain.cell);
+        }
+    }
+    return levels;
+}
+
+#endif
@@ -0,0 +1,43 @@
+#ifndef EMBEDDED_LEVELS_HPP
+#define EMBEDDED_LEVELS_HPP
+
+#include <vector>
+
+#include "level.hpp"
+
+/**
+ * @brief Levels compiled into the binary.
+ *
+ * Built only when MOUZE_EMBEDDED_LEVELS is defined (e.g.
+ * -DMOUZE_EMBEDDED_LEVELS). The pack is embedded_levels.inc: the contents
+ * of one or more .dat files inside a raw string literal, e.g.
+ *
+ *     { printf 'R"mouze('; cat assets/levels.dat; printf ')mouze"\n'; } > source/embedded_levels.inc
+ *
+ * The pack is parsed and validated at compile time (a bad dimension line
+ * or a pack without valid levels stops the build); at startup the levels
+ * are only copied into Level objects, with start position and terrain
+ * cells already resolved.
+ */
+
+#ifdef MOUZE_EMBEDDED_LEVELS
+
+constexpr bool has_embedded_levels(){
+    return true;
+}
+
+std::vector<Level> embedded_levels();
+
+#else
+
+constexpr bool has_embedded_levels(){
+    return false;
+}
+
+inline std::vector<Level> embedded_levels(){
+    return {};
+}
+
+#endif
+
+#endif
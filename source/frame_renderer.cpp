@@ -0,0 +1,89 @@
+#include "frame_renderer.hpp"
+#include "output.hpp"
+
+#include <iostream>
+
+FrameRenderer::~FrameRenderer(){
+    if(!worker.joinable()){
+        return;
+    }
+    drain(); //o último quadro ainda é mostrado
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stop = true;
+    }
+    changed.notify_all();
+    worker.join();
+}
+
+/**
+ * @brief Buffer where the next frame is written; published by submit().
+ */
+
+Frame& FrameRenderer::back(){
+    return frames[writing];
+}
+
+/**
+ * @brief Hands the frame in back() over to the render thread.
+ *
+ * Returns at once. A frame still waiting from an earlier call is dropped,
+ * so the screen always shows the latest state.
+ */
+
+void FrameRenderer::submit(){
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if(ready != -1){
+            std::swap(writing, ready);
+            ++dropped;
+        }else{
+            ready = writing;
+            for(int i=0;i<(int)frames.size();++i){
+                if(i != ready && i != drawing){
+                    writing = i;
+                    break;
+                }
+            }
+        }
+        if(!worker.joinable()){
+            worker = std::thread(&FrameRenderer::loop, this);
+        }
+    }
+    changed.notify_all();
+}
+
+/**
+ * @brief Waits until the last submitted frame has been drawn.
+ *
+ * Used before printing text that must come after the board.
+ */
+
+void FrameRenderer::drain(){
+    std::unique_lock<std::mutex> lock(mutex);
+    changed.wait(lock, [this]{ return ready == -1 && drawing == -1; });
+}
+
+size_t FrameRenderer::dropped_frames() const{
+    std::lock_guard<std::mutex> lock(mutex);
+    return dropped;
+}
+
+void FrameRenderer::loop(){
+    std::unique_lock<std::mutex> lock(mutex);
+    while(true){
+        changed.wait(lock, [this]{ return ready != -1 || stop; });
+        if(ready == -1){
+            return;
+        }
+        drawing = ready;
+        ready = -1;
+
+        lock.unlock();
+        draw_frame(frames[drawing], std::cout);
+        lock.lock();
+
+        drawing = -1;
+        changed.notify_all();
+    }
+}
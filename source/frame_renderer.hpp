@@ -0,0 +1,59 @@
+#ifndef FRAME_RENDERER_HPP
+#define FRAME_RENDERER_HPP
+
+#include <array>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Everything needed to draw one board, copied out of the simulation.
+ */
+
+struct Frame {
+    size_t lives = 0;
+    size_t eaten = 0; //comidas já comidas no nível
+    size_t food = 0;
+    std::vector<std::string> board;
+};
+
+/**
+ * @brief Draws frames on a thread of its own.
+ *
+ * Three frame buffers rotate between the simulation (filling `back()`),
+ * the frame waiting to be drawn and the frame being drawn. `submit()` never
+ * waits for the terminal: if the renderer is still busy with an older
+ * frame, the waiting one is replaced by the new one and counted as dropped.
+ * The lock only guards the buffer indices, never the drawing.
+ */
+
+class FrameRenderer {
+    public:
+        FrameRenderer() = default;
+        ~FrameRenderer();
+        FrameRenderer(const FrameRenderer&) = delete;
+        FrameRenderer& operator=(const FrameRenderer&) = delete;
+
+        Frame& back();
+        void submit();
+        void drain();
+        size_t dropped_frames() const;
+
+    private:
+        std::array<Frame, 3> frames;
+        int writing = 0; //só a simulação mexe neste buffer
+        int ready = -1; //próximo a ser desenhado
+        int drawing = -1;
+        size_t dropped = 0;
+        bool stop = false;
+
+        mutable std::mutex mutex;
+        std::condition_variable changed;
+        std::thread worker; //iniciado no primeiro submit
+
+        void loop();
+};
+
+#endif
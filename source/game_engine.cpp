@@ -0,0 +1,294 @@
+#include "game_engine.hpp"
+#include "simulation.hpp"
+
+#include <iostream>
+
+#ifdef __cpp_impl_coroutine
+
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <thread>
+#include <utility>
+
+GameLoop::GameLoop(const GameSetup& game_setup) : setup(game_setup), cache(game_setup.cache_capacity){
+    resolve_planner(setup.player_type, [this](auto tag){
+        using Planner = typename decltype(tag)::type;
+        step = &walk_route<Planner>;
+        setup.all_food = setup.all_food || Planner::all_food;
+    });
+    tables.reserve(setup.levels->size());
+    for(const Level& level : *setup.levels){
+        tables.push_back(std::make_shared<LevelTables>(level));
+    }
+}
+
+GameLoop::~GameLoop(){
+    for(Game& game : games){
+        game.handle.destroy();
+    }
+}
+
+bool GameLoop::has_planner() const {
+    return step != nullptr;
+}
+
+/**
+ * @brief Creates a game; it starts on the next run().
+ *
+ * @param seed Seed of the food positions, so equal seeds give equal games
+ * (except for randomized planners).
+ * @return Number of the game, used by feed and report.
+ */
+
+size_t GameLoop::spawn(unsigned seed){
+    const size_t id = games.size();
+    games.push_back({Handle{}, {}, {}, false});
+    Game& game = games.back();
+    game.handle = play(*this, id, seed, game.report).handle;
+    game.handle.promise().game = id;
+    ready.push_back(game.handle);
+    max_alive = std::max(max_alive, ++alive);
+    return id;
+}
+
+/**
+ * @brief Gives a line to a game; wakes it up if it was waiting for one.
+ */
+
+void GameLoop::feed(size_t id, std::string line){
+    Game& game = games[id];
+    game.input.push_back(std::move(line));
+    if(game.waiting_input){
+        game.waiting_input = false;
+        ready.push_back(game.handle);
+    }
+}
+
+void GameLoop::wake_after(Handle h, Clock::duration delay){
+    if(delay <= Clock::duration::zero()){
+        ready.push_back(h); //cede a vez aos outros jogos
+        return;
+    }
+    timers.push_back({Clock::now() + delay, timer_order++, h});
+    std::push_heap(timers.begin(), timers.end(), std::greater<>());
+}
+
+bool GameLoop::ReadLine::await_ready() const {
+    return !loop.games[game].input.empty();
+}
+
+void GameLoop::ReadLine::await_suspend(Handle h){
+    if(loop.auto_enter){
+        loop.games[game].input.emplace_back();
+        loop.ready.push_back(h);
+    }else{
+        loop.games[game].waiting_input = true;
+    }
+}
+
+std::string GameLoop::ReadLine::await_resume(){
+    std::deque<std::string>& input = loop.games[game].input;
+    std::string line = std::move(input.front());
+    input.pop_front();
+    return line;
+}
+
+/**
+ * @brief Resumes games until every one has ended or is waiting for a line
+ * that only feed can give.
+ *
+ * The thread sleeps only until the next frame due when no game is ready.
+ * An exception thrown inside a game ends it and is rethrown here.
+ *
+ * @return Games not ended yet.
+ */
+
+size_t GameLoop::run(){
+    std::deque<Handle> turn;
+    while(true){
+        //acorda os quadros vencidos
+        const Clock::time_point now = Clock::now();
+        while(!timers.empty() && timers.front().when <= now){
+            ready.push_back(timers.front().handle);
+            std::pop_heap(timers.begin(), timers.end(), std::greater<>());
+            timers.pop_back();
+        }
+
+        if(ready.empty()){
+            if(timers.empty()){
+                return alive;
+            }
+            std::this_thread::sleep_until(timers.front().when);
+            continue;
+        }
+
+        //os que ficarem prontos nesta volta esperam a próxima
+        turn.swap(ready);
+        for(Handle h : turn){
+            h.resume();
+            if(h.done()){
+                --alive;
+                if(h.promise().error){
+                    std::rethrow_exception(h.promise().error);
+                }
+            }
+        }
+        turn.clear();
+    }
+}
+
+/**
+ * @brief Body of one game: the states of MouzeSimulation without drawing.
+ */
+
+GameLoop::Task GameLoop::play(GameLoop& loop, size_t game, unsigned seed, GameReport& report){
+    const GameSetup& setup = loop.setup;
+    const std::chrono::milliseconds frame(setup.fps);
+
+    co_await loop.read_line(game); //WELCOME: pressionar enter
+
+    size_t lives = setup.lives;
+    std::mt19937 generator;
+    for(size_t idx = 0; idx < setup.levels->size(); ++idx){
+        Level level = (*setup.levels)[idx]; //só o nível em jogo fica no quadro
+        generator.seed(seed + (unsigned)idx);
+        Player player(level, loop.tables[idx]);
+        player.plan_budget_us = setup.plan_budget_us;
+        player.ida_table_size = setup.ida_table_size;
+
+        RouteWalk walk;
+        walk.cache = setup.cache_capacity > 0 && !setup.all_food ? &loop.cache : nullptr;
+        walk.level = (std::uint32_t)idx;
+        Point head = level.start_mouse;
+        bool initial = true;
+        bool food_placed = false;
+
+        while(player.get_mouse_size() < setup.food){
+            //LOAD_LEVEL
+            if(!setup.all_food){
+                level.generate_food(generator);
+            }else if(!food_placed){
+                level.generate_all_food(setup.food, generator);
+                food_placed = true;
+            }
+            if(initial){
+                level.current_mouse = level.start_mouse;
+                head = level.start_mouse;
+                level.reset_level(true);
+                co_await loop.sleep_for(frame);
+                initial = false;
+                walk.replan = true;
+            }
+            level.fill_data(head, false);
+            co_await loop.sleep_for(frame);
+
+            //THINKING e RUNNING até comer ou bater
+            StepResult result;
+            do{
+                if(setup.max_steps > 0 && report.steps >= setup.max_steps){
+                    report.outcome = GameOutcome::STALLED;
+                    co_return;
+                }
+                ++report.steps;
+                result = loop.step(player, level, head, walk);
+                if(result == StepResult::MOVED){
+                    report.score += 5;
+                }
+                level.reset_level(false);
+                level.fill_data(head, result == StepResult::CRASHED);
+                co_await loop.sleep_for(frame);
+            }while(result != StepResult::ATE && result != StepResult::CRASHED);
+
+            if(result == StepResult::ATE){
+                report.score += 100;
+                player.increase_mouse_size();
+                continue;
+            }
+
+            //CRASHED: pressionar enter
+            co_await loop.read_line(game);
+            initial = true;
+            level.current_mouse = level.start_mouse;
+            if(!setup.all_food){
+                level.board[level.food_mouse.x][level.food_mouse.y] = ' ';
+            }
+            if(--lives == 0){
+                report.outcome = GameOutcome::LOST;
+                co_return;
+            }
+        }
+
+        //LEVEL_UP
+        report.score += 250;
+        ++report.levels_cleared;
+        if(idx + 1 < setup.levels->size()){
+            co_await loop.read_line(game);
+        }
+    }
+    report.outcome = GameOutcome::WON;
+}
+
+#endif
+
+/**
+ * @brief Plays `game_count` games at once on this thread (--games) and
+ * prints how they ended.
+ *
+ * Uses the settings of the simulation; <ENTER> is pressed automatically
+ * and a game that takes more than GAME_STEP_LIMIT steps is given up.
+ */
+
+void MouzeSimulation::run_games(){
+#ifdef __cpp_impl_coroutine
+    const size_t GAME_STEP_LIMIT = 100000;
+
+    GameSetup setup;
+    setup.levels = &levels;
+    setup.player_type = player_type;
+    setup.fps = fps;
+    setup.lives = lives;
+    setup.food = food;
+    setup.all_food = all_food;
+    setup.plan_budget_us = plan_budget_us;
+    setup.ida_table_size = ida_table_size;
+    setup.max_steps = GAME_STEP_LIMIT;
+    setup.cache_capacity = cache_capacity;
+
+    GameLoop loop(setup);
+    for(size_t i = 0; i < game_count; ++i){
+        loop.spawn((unsigned)i);
+    }
+
+    auto begin = std::chrono::steady_clock::now();
+    loop.run();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+    size_t won = 0;
+    size_t lost = 0;
+    size_t stalled = 0;
+    size_t steps = 0;
+    double score = 0;
+    for(size_t i = 0; i < loop.size(); ++i){
+        const GameReport& report = loop.report(i);
+        won += report.outcome == GameOutcome::WON;
+        lost += report.outcome == GameOutcome::LOST;
+        stalled += report.outcome == GameOutcome::STALLED;
+        steps += report.steps;
+        score += report.score;
+    }
+
+    std::cout << "Games: " << loop.size() << " on one thread (" << loop.peak_alive() << " at once), player " << player_type << ", fps " << fps << "\n";
+    std::cout << "  won " << won << ", lost " << lost << ", gave up " << stalled << "\n";
+    std::cout << "  mean score " << (loop.size() ? score / loop.size() : 0) << ", " << steps << " steps in " << seconds << " s ("
+              << (seconds > 0 ? steps / seconds : 0) << " steps/s)\n";
+    if(cache_capacity > 0){
+        const PathCache& cache = loop.get_cache();
+        std::cout << "  path cache: " << cache.hits() << " hits, " << cache.misses() << " misses (" << cache.hit_rate() * 100 << "%), "
+                  << cache.size() << " paths, " << cache.memory_bytes() / 1024 << " KiB\n";
+    }
+#else
+    std::cout << "Error: --games needs a build with C++20 coroutines (e.g. -std=c++20).\n";
+    exit(1);
+#endif
+}
@@ -0,0 +1,175 @@
+#ifndef GAME_ENGINE_HPP
+#define GAME_ENGINE_HPP
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "level.hpp"
+#include "player.hpp"
+#include "planner.hpp"
+
+/**
+ * @brief Settings shared by every game of a GameLoop.
+ */
+
+struct GameSetup {
+    const std::vector<Level>* levels = nullptr; //copiados nível a nível por cada jogo; devem viver mais que o GameLoop
+    std::string player_type = "A*";
+    int fps = 300; //espera entre quadros, em milissegundos (como --fps)
+    size_t lives = 5;
+    size_t food = 10;
+    bool all_food = false;
+    long plan_budget_us = 2000;
+    size_t ida_table_size = IdaSearch::DEFAULT_TABLE_SIZE;
+    size_t max_steps = 0; //passos da cabeça antes de desistir do jogo (0 = sem limite)
+    size_t cache_capacity = 0; //caminhos guardados no cache comum aos jogos (0 = sem cache)
+};
+
+enum class GameOutcome { PLAYING, WON, LOST, STALLED };
+
+struct GameReport {
+    GameOutcome outcome = GameOutcome::PLAYING;
+    size_t score = 0;
+    size_t levels_cleared = 0;
+    size_t steps = 0; //passos da cabeça (THINKING)
+};
+
+/**
+ * @brief Many headless games multiplexed on one thread with C++20
+ * coroutines.
+ *
+ * Built only when the compiler has coroutines (e.g. -std=c++20); otherwise
+ * has_game_loop() is false and no engine code is compiled.
+ *
+ * Each game is a coroutine that follows the states of MouzeSimulation
+ * without drawing: it suspends where the simulation sleeps for a frame
+ * (`co_await sleep_for`) and where it waits for <ENTER> (`co_await
+ * read_line`). `run` resumes the games whose frame is due or whose line
+ * arrived and sleeps the thread only when every game is waiting, so a game
+ * costs its coroutine frame (level and player included) instead of a
+ * thread. The head moves with walk_route, as in the simulation; the games
+ * of a loop share the read-only LevelTables of each level (built once, by
+ * the first game that needs them) and one PathCache when
+ * setup.cache_capacity is set.
+ *
+ * Lines come from `feed`; with `auto_enter` every request is answered with
+ * an empty line on the next turn of the loop (like piping `yes ''`).
+ */
+
+#ifdef __cpp_impl_coroutine
+
+#include <chrono>
+#include <coroutine>
+#include <deque>
+#include <exception>
+
+constexpr bool has_game_loop(){
+    return true;
+}
+
+class GameLoop {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        class Task {
+            public:
+                struct promise_type {
+                    size_t game = 0;
+                    std::exception_ptr error;
+
+                    Task get_return_object(){ return Task(Handle::from_promise(*this)); }
+                    std::suspend_always initial_suspend() noexcept { return {}; }
+                    std::suspend_always final_suspend() noexcept { return {}; }
+                    void return_void(){}
+                    void unhandled_exception(){ error = std::current_exception(); }
+                };
+                using Handle = std::coroutine_handle<promise_type>;
+
+                explicit Task(Handle h) : handle(h) {}
+                Handle handle;
+        };
+        using Handle = Task::Handle;
+
+        struct Sleep {
+            GameLoop& loop;
+            Clock::duration delay;
+
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(Handle h){ loop.wake_after(h, delay); }
+            void await_resume() const noexcept {}
+        };
+
+        struct ReadLine {
+            GameLoop& loop;
+            size_t game;
+
+            bool await_ready() const;
+            void await_suspend(Handle h);
+            std::string await_resume();
+        };
+
+        explicit GameLoop(const GameSetup& setup);
+        ~GameLoop();
+        GameLoop(const GameLoop&) = delete;
+        GameLoop& operator=(const GameLoop&) = delete;
+
+        bool has_planner() const;
+        size_t spawn(unsigned seed);
+        void feed(size_t game, std::string line);
+        size_t run();
+
+        Sleep sleep_for(std::chrono::milliseconds delay){ return {*this, delay}; }
+        ReadLine read_line(size_t game){ return {*this, game}; }
+
+        bool auto_enter = true;
+        size_t size() const { return games.size(); }
+        const GameReport& report(size_t game) const { return games[game].report; }
+        size_t peak_alive() const { return max_alive; }
+        const PathCache& get_cache() const { return cache; }
+
+    private:
+        using StepFn = StepResult (*)(Player&, Level&, Point&, RouteWalk&);
+
+        struct Game {
+            Handle handle;
+            GameReport report;
+            std::deque<std::string> input;
+            bool waiting_input = false;
+        };
+
+        struct Timer {
+            Clock::time_point when;
+            size_t order; //na mesma hora, quem pediu antes acorda antes
+            Handle handle;
+
+            bool operator>(const Timer& other) const {
+                return when != other.when ? when > other.when : order > other.order;
+            }
+        };
+
+        GameSetup setup;
+        StepFn step = nullptr;
+        PathCache cache;
+        std::vector<std::shared_ptr<LevelTables>> tables; //um por nível de setup.levels, comuns aos jogos
+        std::deque<Game> games; //endereços estáveis: o corpo do jogo guarda o seu relatório
+        std::deque<Handle> ready;
+        std::vector<Timer> timers; //heap com std::greater
+        size_t timer_order = 0;
+        size_t alive = 0;
+        size_t max_alive = 0;
+
+        void wake_after(Handle h, Clock::duration delay);
+        static Task play(GameLoop& loop, size_t game, unsigned seed, GameReport& report);
+};
+
+#else
+
+constexpr bool has_game_loop(){
+    return false;
+}
+
+#endif
+
+#endif
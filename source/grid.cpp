@@ -0,0 +1,153 @@
+#include "grid.hpp"
+
+#include <algorithm>
+
+namespace {
+    size_t chunks_for(size_t cells){
+        return (cells + Grid::CHUNK - 1) / Grid::CHUNK;
+    }
+}
+
+/**
+ * @brief Makes the grid `rows` copies of `row`, like std::vector::assign.
+ */
+
+void Grid::assign(size_t rows, const std::string& row){
+    lengths.assign(rows, row.size());
+    Chunk fill;
+    fill.uniform = row.empty() ? ' ' : row[0];
+    chunk_cols = chunks_for(row.size());
+    chunks.assign(chunks_for(rows) * chunk_cols, fill);
+
+    if(std::all_of(row.begin(), row.end(), [&](char c){ return c == fill.uniform; })){
+        return;
+    }
+    for(size_t x=0;x<rows;++x){
+        set_row(x, row);
+    }
+    compact();
+}
+
+/**
+ * @brief Changes the number of rows; new rows are empty.
+ */
+
+void Grid::resize(size_t rows){
+    lengths.resize(rows, 0);
+    chunks.resize(chunks_for(rows) * chunk_cols);
+}
+
+/**
+ * @brief Replaces row x, like assigning a std::string to it.
+ *
+ * Only chunks that get a cell different from their uniform value are
+ * allocated.
+ */
+
+void Grid::set_row(int x, std::string_view row){
+    lengths[x] = row.size();
+    reserve_width(row.size());
+    for(size_t y=0;y<row.size();++y){
+        set(x, y, row[y]);
+    }
+}
+
+void Grid::set(int x, int y, char cell){
+    reserve_width(y + 1);
+    Chunk& chunk = chunks[(x >> CHUNK_BITS) * chunk_cols + (y >> CHUNK_BITS)];
+    if(chunk.cells.empty()){
+        if(cell == chunk.uniform){
+            return;
+        }
+        chunk.cells.assign(CHUNK * CHUNK, chunk.uniform);
+    }
+    chunk.cells[offset(x, y)] = cell;
+}
+
+/**
+ * @brief Writes the rows as strings, reusing the memory already in `rows`.
+ */
+
+void Grid::copy_to(std::vector<std::string>& rows) const{
+    rows.resize(size());
+    for(size_t x=0;x<size();++x){
+        rows[x].resize(lengths[x]);
+        for(size_t y=0;y<lengths[x];++y){
+            rows[x][y] = at(x, y);
+        }
+    }
+}
+
+/**
+ * @brief Turns allocated chunks whose cells are all equal back into a single value.
+ *
+ * Cells past the end of their row are not considered.
+ */
+
+void Grid::compact(){
+    for(size_t cx=0;cx<chunks_for(size());++cx){
+        for(size_t cy=0;cy<chunk_cols;++cy){
+            Chunk& chunk = chunks[cx * chunk_cols + cy];
+            if(chunk.cells.empty()){
+                continue;
+            }
+
+            bool uniform = true;
+            bool seen = false;
+            char value = chunk.uniform;
+            const size_t x_end = std::min(lengths.size(), (cx + 1) * CHUNK);
+            for(size_t x = cx * CHUNK; x < x_end && uniform; ++x){
+                const size_t y_end = std::min(lengths[x], (cy + 1) * CHUNK);
+                for(size_t y = cy * CHUNK; y < y_end; ++y){
+                    char cell = chunk.cells[offset(x, y)];
+                    if(!seen){
+                        value = cell;
+                        seen = true;
+                    }else if(cell != value){
+                        uniform = false;
+                        break;
+                    }
+                }
+            }
+
+            if(uniform){
+                chunk.uniform = value;
+                std::vector<char>().swap(chunk.cells);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Approximate heap memory used by the grid, in bytes.
+ */
+
+size_t Grid::memory_bytes() const{
+    size_t bytes = lengths.capacity() * sizeof(size_t) + chunks.capacity() * sizeof(Chunk);
+    for(const Chunk& chunk : chunks){
+        bytes += chunk.cells.capacity();
+    }
+    return bytes;
+}
+
+/**
+ * @brief Makes sure the rows have chunks for `length` cells.
+ *
+ * Every chunk row keeps the same number of chunks, so any cell up to the
+ * widest row can be read.
+ */
+
+void Grid::reserve_width(size_t length){
+    const size_t needed = chunks_for(length);
+    if(chunk_cols >= needed){
+        return;
+    }
+    std::vector<Chunk> wider(chunks_for(size()) * needed);
+    for(size_t cx=0;cx<chunks_for(size());++cx){
+        for(size_t cy=0;cy<chunk_cols;++cy){
+            wider[cx * needed + cy] = std::move(chunks[cx * chunk_cols + cy]);
+        }
+    }
+    chunks = std::move(wider);
+    chunk_cols = needed;
+}
@@ -0,0 +1,109 @@
+#ifndef GRID_HPP
+#define GRID_HPP
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Board of a level stored in square chunks.
+ *
+ * A chunk whose cells are all the same (open floor, solid rock) is stored
+ * as that single value; the CHUNK x CHUNK cells are only allocated when a
+ * different value is written into it. Memory therefore grows with the
+ * detail of the map, not with its area.
+ *
+ * Indexing works like the std::vector<std::string> it replaces:
+ * `board[x][y]` reads or writes a cell and `board[x].size()` is the length
+ * of row x (rows of a level file may be shorter than the level width).
+ * Reading a cell outside the chunks (a row that does not exist, or a column
+ * past the widest row) gives a wall, '#', so a level whose header is wider
+ * than its rows never reads outside the grid.
+ */
+
+class Grid {
+    public:
+        static const int CHUNK_BITS = 6;
+        static const int CHUNK = 1 << CHUNK_BITS; //lado do bloco, em células
+
+        class CellRef {
+            public:
+                CellRef(Grid& grid, int x, int y) : grid(grid), x(x), y(y) {}
+                operator char() const { return grid.at(x, y); }
+                CellRef& operator=(char cell){
+                    grid.set(x, y, cell);
+                    return *this;
+                }
+                CellRef& operator=(const CellRef& other){
+                    return *this = static_cast<char>(other);
+                }
+
+            private:
+                Grid& grid;
+                int x;
+                int y;
+        };
+
+        class RowRef {
+            public:
+                RowRef(Grid& grid, int x) : grid(grid), x(x) {}
+                CellRef operator[](int y) const { return CellRef(grid, x, y); }
+                size_t size() const { return grid.lengths[x]; }
+
+            private:
+                Grid& grid;
+                int x;
+        };
+
+        class ConstRowRef {
+            public:
+                ConstRowRef(const Grid& grid, int x) : grid(grid), x(x) {}
+                char operator[](int y) const { return grid.at(x, y); }
+                size_t size() const { return grid.lengths[x]; }
+
+            private:
+                const Grid& grid;
+                int x;
+        };
+
+        RowRef operator[](int x) { return RowRef(*this, x); }
+        ConstRowRef operator[](int x) const { return ConstRowRef(*this, x); }
+
+        size_t size() const { return lengths.size(); }
+        bool empty() const { return lengths.empty(); }
+
+        void assign(size_t rows, const std::string& row);
+        void resize(size_t rows);
+        void set_row(int x, std::string_view row);
+        void copy_to(std::vector<std::string>& rows) const;
+        void compact();
+        size_t memory_bytes() const;
+
+        char at(int x, int y) const {
+            if((size_t)x >= lengths.size() || (size_t)(y >> CHUNK_BITS) >= chunk_cols){
+                return '#';
+            }
+            const Chunk& chunk = chunks[(x >> CHUNK_BITS) * chunk_cols + (y >> CHUNK_BITS)];
+            return chunk.cells.empty() ? chunk.uniform : chunk.cells[offset(x, y)];
+        }
+
+        void set(int x, int y, char cell);
+
+    private:
+        struct Chunk {
+            char uniform = ' '; //valor de todas as células enquanto `cells` estiver vazio
+            std::vector<char> cells;
+        };
+
+        std::vector<size_t> lengths; //tamanho de cada linha
+        std::vector<Chunk> chunks; //[(x / CHUNK) * chunk_cols + y / CHUNK]
+        size_t chunk_cols = 0;
+
+        static size_t offset(int x, int y){
+            return ((x & (CHUNK - 1)) << CHUNK_BITS) | (y & (CHUNK - 1));
+        }
+        void reserve_width(size_t length);
+};
+
+#endif
@@ -0,0 +1,66 @@
+#include "benchmark.hpp"
+#include "grid.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+
+/**
+ * @brief Measures the memory of the chunked board on giant maps.
+ *
+ * Builds solid-rock maps with open rooms joined by corridors and
+ * compares the memory of the Grid with the rows * cols bytes of a dense
+ * board, then times random cell reads.
+ */
+
+void bench_grid(){
+    std::cout << "\n[CHUNKED BOARD ON GIANT MAPS (" << Grid::CHUNK << "x" << Grid::CHUNK << " chunks)]\n";
+    std::cout << std::setw(14) << "map" << std::setw(8) << "rooms" << std::setw(14) << "dense MB"
+              << std::setw(14) << "grid MB" << std::setw(12) << "build ms" << std::setw(12) << "read ns" << std::setw(8) << "open" << "\n";
+
+    for(int side : {2000, 20000, 50000}){
+        for(int rooms : {10, 200}){
+            std::mt19937 gen(side + rooms);
+            std::uniform_int_distribution<int> place(1, side - 101);
+            auto begin = Clock::now();
+
+            Grid grid;
+            grid.assign(side, std::string(side, '#'));
+            Point previous{side / 2, side / 2};
+            for(int r=0;r<rooms;++r){
+                Point corner{place(gen), place(gen)};
+                for(int x=corner.x;x<corner.x + 100;++x){
+                    for(int y=corner.y;y<corner.y + 100;++y){
+                        grid.set(x, y, ' ');
+                    }
+                }
+                //corredor em L até a sala anterior
+                for(int y=std::min(previous.y, corner.y);y<=std::max(previous.y, corner.y);++y){
+                    grid.set(previous.x, y, ' ');
+                }
+                for(int x=std::min(previous.x, corner.x);x<=std::max(previous.x, corner.x);++x){
+                    grid.set(x, corner.y, ' ');
+                }
+                previous = corner;
+            }
+            grid.compact();
+            double build_ms = elapsed_ms(begin);
+
+            std::uniform_int_distribution<int> any(0, side - 1);
+            const int reads = 1000000;
+            size_t open = 0;
+            begin = Clock::now();
+            for(int k=0;k<reads;++k){
+                open += grid.at(any(gen), any(gen)) != '#';
+            }
+            double read_ns = elapsed_ms(begin) * 1e6 / reads;
+
+            std::cout << std::setw(14) << (std::to_string(side) + "x" + std::to_string(side)) << std::setw(8) << rooms
+                      << std::setw(14) << std::fixed << std::setprecision(1) << (double)side * side / 1e6
+                      << std::setw(14) << grid.memory_bytes() / 1e6 << std::setw(12) << build_ms
+                      << std::setw(12) << read_ns << std::setw(7) << 100.0 * open / reads << "%\n";
+        }
+    }
+}
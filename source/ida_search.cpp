@@ -0,0 +1,120 @@
+#include "ida_search.hpp"
+#include "level.hpp"
+#include "search.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace {
+    const unsigned char OPPOSITE[5] = {Dir::S, Dir::N, Dir::O, Dir::L, 4};
+
+    int manhattan(Point a, Point b){
+        return std::abs(a.x - b.x) + std::abs(a.y - b.y);
+    }
+}
+
+/**
+ * @param table_entries Entries of the transposition table, rounded up to
+ * a power of two; 0 searches without a table.
+ */
+
+IdaSearch::IdaSearch(size_t table_entries){
+    set_table_size(table_entries);
+}
+
+void IdaSearch::set_table_size(size_t entries){
+    size_t size = 0;
+    if(entries > 0){
+        size = 1;
+        while(size < entries) size <<= 1;
+    }
+    table.assign(size, Slot());
+    table.shrink_to_fit();
+    iteration = 0;
+}
+
+/**
+ * @brief Finds a least-cost path from `start` to `goal`.
+ *
+ * @param path Receives the cells after start, up to the goal.
+ * @return False if there is no path or the expansion limit was reached.
+ */
+
+bool IdaSearch::search(const Level& level, Point start, Point goal, std::vector<Point>& path){
+    path.clear();
+    expanded = 0;
+    iteration_count = 0;
+    if(!is_open_cell(level, start.x, start.y) || !is_open_cell(level, goal.x, goal.y)){
+        return false;
+    }
+    if(start == goal){
+        return true;
+    }
+
+    const size_t mask = table.size() - 1;
+    int threshold = manhattan(start, goal);
+    while(true){
+        ++iteration_count;
+        if(++iteration == 0){
+            //a marca deu a volta: entradas antigas poderiam parecer atuais
+            std::fill(table.begin(), table.end(), Slot());
+            iteration = 1;
+        }
+
+        int next_threshold = UNREACHABLE;
+        stack.clear();
+        stack.push_back({start, 0, 0, 4});
+        while(!stack.empty()){
+            Frame& top = stack.back();
+            if(top.next == 4){
+                stack.pop_back();
+                continue;
+            }
+            const int d = top.next++;
+            if(d == OPPOSITE[top.from]) continue; //voltar pelo mesmo passo
+
+            const Point next{top.cell.x + MOVES[d].x, top.cell.y + MOVES[d].y};
+            if(!is_open_cell(level, next.x, next.y)) continue;
+            const int g = top.g + level.terrain_cost(level.board[next.x][next.y]);
+            const int f = g + manhattan(next, goal);
+            if(f > threshold){
+                next_threshold = std::min(next_threshold, f);
+                continue;
+            }
+
+            if(next == goal){
+                for(size_t k = 1; k < stack.size(); ++k){
+                    path.push_back(stack[k].cell);
+                }
+                path.push_back(next);
+                return true;
+            }
+
+            if(!table.empty()){
+                const int cell = next.x * level.cols + next.y;
+                Slot& slot = table[((size_t)cell * 2654435761u) & mask];
+                if(slot.iteration == iteration && slot.cell == cell && slot.g <= g) continue;
+                slot = {cell, g, iteration};
+            }
+
+            if(++expanded > expansion_limit){
+                return false;
+            }
+            stack.push_back({next, g, 0, (unsigned char)d});
+        }
+
+        if(next_threshold == UNREACHABLE){
+            return false;
+        }
+        threshold = next_threshold;
+    }
+}
+
+/**
+ * @brief Memory the search holds: the stack, as deep as it ever went, and
+ * the table.
+ */
+
+size_t IdaSearch::peak_bytes() const {
+    return stack.capacity() * sizeof(Frame) + table.capacity() * sizeof(Slot);
+}
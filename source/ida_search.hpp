@@ -0,0 +1,68 @@
+#ifndef IDA_SEARCH_HPP
+#define IDA_SEARCH_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include "direction.hpp"
+
+class Level;
+
+/**
+ * @brief Iterative-deepening A* (IDA*) with an optional fixed-size
+ * transposition table.
+ *
+ * Each iteration is a depth-first search that cuts every branch whose
+ * f = g + Manhattan exceeds the threshold; the next threshold is the
+ * smallest f cut. With terrain costs of at least 1 the Manhattan distance
+ * is admissible, so the first path found has the least terrain cost.
+ *
+ * Memory grows only with the depth of the path being tried (one Frame per
+ * cell on the stack) plus the table, whose size is fixed up front: no
+ * per-cell array of the level is allocated. The table is direct-mapped and
+ * remembers, for the current iteration, the smallest g each cell was
+ * reached with; a later visit with no smaller g is cut, which keeps open
+ * areas from blowing up. An entry that is overwritten only loses that
+ * pruning. With no table only stepping straight back is cut, which is
+ * enough in corridors but exponential in open rooms.
+ *
+ * `search` gives up (no path) after `expansion_limit` expansions.
+ */
+
+class IdaSearch {
+    public:
+        static const size_t DEFAULT_TABLE_SIZE = 4096;
+        static const size_t DEFAULT_EXPANSION_LIMIT = 50000000;
+
+        explicit IdaSearch(size_t table_entries = DEFAULT_TABLE_SIZE);
+
+        void set_table_size(size_t entries);
+        bool search(const Level& level, Point start, Point goal, std::vector<Point>& path);
+
+        size_t expansion_limit = DEFAULT_EXPANSION_LIMIT;
+        size_t nodes_expanded() const { return expanded; }
+        int iterations() const { return iteration_count; }
+        size_t peak_bytes() const;
+
+    private:
+        struct Frame {
+            Point cell;
+            int g;
+            unsigned char next; //próxima direção a tentar
+            unsigned char from; //direção usada para chegar (4 na origem)
+        };
+
+        struct Slot {
+            int cell = -1;
+            int g = 0;
+            unsigned iteration = 0;
+        };
+
+        std::vector<Frame> stack;
+        std::vector<Slot> table; //tamanho potência de 2, ou vazio
+        unsigned iteration = 0; //marca das entradas da iteração atual
+        int iteration_count = 0;
+        size_t expanded = 0;
+};
+
+#endif
@@ -0,0 +1,86 @@
+#include "benchmark.hpp"
+#include "ida_search.hpp"
+#include "maze.hpp"
+#include "path_query.hpp"
+#include "player.hpp"
+
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+/**
+ * @brief IDA* against A* on generated mazes.
+ *
+ * The same random pairs are answered by the A* of Player (without
+ * landmarks, so both use Manhattan) and by IDA* with and without a
+ * transposition table. Memory is what each search holds at its peak:
+ * the A* scratch arena (per-cell arrays and open list) against the
+ * IDA* stack and table. Costs must match; "-" means the IDA* without a
+ * table hit its expansion limit.
+ */
+
+void bench_ida(){
+    const int pairs = 10;
+    std::cout << "\n[IDA* x A* (" << pairs << " pairs per maze)]\n";
+    std::cout << std::left << std::setw(16) << "maze" << std::setw(10) << "table" << std::right << std::setw(11) << "A* ms"
+              << std::setw(11) << "A* KiB" << std::setw(11) << "IDA* ms" << std::setw(11) << "IDA* KiB" << std::setw(11) << "iterations"
+              << std::setw(13) << "expansions" << "\n";
+
+    for(int side : {41, 81, 121}){
+        Level level = generate_maze(side, side, 13, 10, 20);
+        const std::vector<PathQuery> batch = QuerySampler(level, side).queries(pairs);
+
+        Player player(level);
+        player.use_landmarks = false;
+        std::vector<int> astar_cost(pairs);
+        auto begin = Clock::now();
+        for(int k=0;k<pairs;++k){
+            player.computed_path_A(batch[k].start, batch[k].goal);
+            astar_cost[k] = player.get_valid_path() ? path_cost(level, player.path) : -1;
+        }
+        double astar_ms = elapsed_ms(begin);
+        double astar_kib = player.scratch_capacity() / 1024.0;
+
+        for(size_t table : {(size_t)0, IdaSearch::DEFAULT_TABLE_SIZE, (size_t)65536}){
+            //sem tabela só o labirinto menor termina em tempo razoável
+            if(table == 0 && side > 41) continue;
+
+            IdaSearch ida(table);
+            ida.expansion_limit = table == 0 ? 20000000 : IdaSearch::DEFAULT_EXPANSION_LIMIT;
+            std::vector<Point> path;
+            size_t iterations = 0;
+            size_t expansions = 0;
+            size_t mismatches = 0;
+            size_t gave_up = 0;
+            begin = Clock::now();
+            for(int k=0;k<pairs;++k){
+                bool found = ida.search(level, batch[k].start, batch[k].goal, path);
+                iterations += ida.iterations();
+                expansions += ida.nodes_expanded();
+                if(!found && astar_cost[k] >= 0 && ida.nodes_expanded() > ida.expansion_limit){
+                    ++gave_up;
+                }else if((found ? path_cost(level, path) : -1) != astar_cost[k]){
+                    ++mismatches;
+                }
+            }
+            double ida_ms = elapsed_ms(begin);
+
+            std::cout << std::left << std::setw(16) << ("maze " + std::to_string(side) + "x" + std::to_string(side))
+                      << std::setw(10) << table << std::right << std::fixed << std::setprecision(1)
+                      << std::setw(11) << astar_ms << std::setw(11) << astar_kib;
+            if(gave_up){
+                std::cout << std::setw(11) << "-";
+            }else{
+                std::cout << std::setw(11) << ida_ms;
+            }
+            std::cout << std::setw(11) << ida.peak_bytes() / 1024.0 << std::setw(11) << iterations / pairs
+                      << std::setw(13) << expansions / pairs << "\n";
+            if(mismatches){
+                std::cout << "  ! " << mismatches << " paths with different costs\n";
+            }
+            if(gave_up){
+                std::cout << "  " << gave_up << " searches gave up\n";
+            }
+        }
+    }
+}
@@ -0,0 +1,126 @@
+#include "landmarks.hpp"
+#include "level.hpp"
+#include "search.hpp"
+
+#include <algorithm>
+
+/**
+ * @brief Chooses the landmarks of a level and computes their distance tables.
+ *
+ * The first landmark is the cell farthest from the first passable cell; each
+ * following one is the cell whose distance to the closest landmark already
+ * chosen is the largest (farthest-point selection), which spreads them over
+ * the border of the maze where ALT bounds are the tightest.
+ *
+ * @param level Level to preprocess; only walls and terrain are used.
+ * @param count Maximum number of landmarks.
+ */
+
+void Landmarks::build(const Level& level, int count){
+    rows = level.rows;
+    cols = level.cols;
+    const int cells = rows * cols;
+    landmarks.clear();
+    dist_from.clear();
+    dist_to.clear();
+
+    Point seed{-1, -1};
+    for(int i=0;i<rows && seed.x < 0;++i){
+        for(int j=0;j<cols;++j){
+            if(is_open_cell(level, i, j)){
+                seed = {i, j};
+                break;
+            }
+        }
+    }
+    if(seed.x < 0 || count <= 0){
+        return;
+    }
+
+    std::vector<int> scratch;
+    dijkstra(level, seed, scratch);
+    //distância até o landmark mais próximo, usada na escolha do próximo
+    std::vector<int> closest(cells, UNREACHABLE);
+
+    Point next = seed;
+    int far = -1;
+    for(int idx=0;idx<cells;++idx){
+        if(scratch[idx] != UNREACHABLE && scratch[idx] > far){
+            far = scratch[idx];
+            next = {idx / cols, idx % cols};
+        }
+    }
+
+    for(int l=0;l<count;++l){
+        landmarks.push_back(next);
+        dist_from.emplace_back();
+        dist_to.emplace_back();
+        dijkstra(level, next, dist_from.back());
+        dijkstra(level, next, dist_to.back(), nullptr, true);
+
+        far = 0;
+        const std::vector<int>& from = dist_from.back();
+        for(int idx=0;idx<cells;++idx){
+            closest[idx] = std::min(closest[idx], from[idx]);
+            if(closest[idx] != UNREACHABLE && closest[idx] > far){
+                far = closest[idx];
+                next = {idx / cols, idx % cols};
+            }
+        }
+        //todas as células já coincidem com algum landmark
+        if(far == 0){
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Lower bound on the cost of going from one cell to another.
+ *
+ * Uses the triangle inequality with every landmark L:
+ * d(from,to) >= d(L,to) - d(L,from) and d(from,to) >= d(from,L) - d(to,L).
+ *
+ * @return The largest bound over all landmarks, or 0 if there are none.
+ */
+
+int Landmarks::lower_bound(Point from, Point to) const{
+    const int a = from.x * cols + from.y;
+    const int b = to.x * cols + to.y;
+    int bound = 0;
+
+    for(size_t l=0;l<landmarks.size();++l){
+        const std::vector<int>& f = dist_from[l];
+        const std::vector<int>& t = dist_to[l];
+        if(f[a] != UNREACHABLE && f[b] != UNREACHABLE){
+            bound = std::max(bound, f[b] - f[a]);
+        }
+        if(t[a] != UNREACHABLE && t[b] != UNREACHABLE){
+            bound = std::max(bound, t[a] - t[b]);
+        }
+    }
+    return bound;
+}
+
+size_t Landmarks::count() const{
+    return landmarks.size();
+}
+
+const std::vector<Point>& Landmarks::get_landmarks() const{
+    return landmarks;
+}
+
+/**
+ * @brief Distances from landmark l to every cell (x * cols + y).
+ */
+
+const std::vector<int>& Landmarks::distances_from(size_t l) const{
+    return dist_from[l];
+}
+
+/**
+ * @brief Distances from every cell (x * cols + y) to landmark l.
+ */
+
+const std::vector<int>& Landmarks::distances_to(size_t l) const{
+    return dist_to[l];
+}
@@ -0,0 +1,39 @@
+#ifndef LANDMARKS_HPP
+#define LANDMARKS_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include "direction.hpp"
+
+class Level;
+
+/**
+ * @brief ALT (A*, landmarks, triangle inequality) lower bounds for a level.
+ *
+ * A few landmark cells are chosen far apart from each other and, for each of
+ * them, the exact terrain-weighted distances from the landmark to every cell
+ * and from every cell to the landmark are stored. Since moving costs the
+ * terrain of the cell entered, the two directions differ and both tables are
+ * needed for the bound to stay admissible.
+ */
+
+class Landmarks {
+    public:
+        void build(const Level& level, int count);
+        int lower_bound(Point from, Point to) const;
+        size_t count() const;
+        const std::vector<Point>& get_landmarks() const;
+        const std::vector<int>& distances_from(size_t l) const;
+        const std::vector<int>& distances_to(size_t l) const;
+
+    private:
+        int rows = 0;
+        int cols = 0;
+        std::vector<Point> landmarks;
+        //tabelas de distância por landmark, indexadas por x * cols + y
+        std::vector<std::vector<int>> dist_from;
+        std::vector<std::vector<int>> dist_to;
+};
+
+#endif
@@ -0,0 +1,63 @@
+#include "benchmark.hpp"
+#include "player.hpp"
+
+#include <iomanip>
+#include <iostream>
+#include <memory>
+
+/**
+ * @brief Compares nodes expanded by A* with Manhattan and ALT heuristics.
+ *
+ * Runs both versions over the same random start/goal pairs of every board
+ * and checks that the path costs match (both heuristics are admissible).
+ */
+
+void bench_alt(const std::vector<Level>& levels){
+    const int pairs = 200;
+    std::cout << "\n[A* HEURISTIC: MANHATTAN x ALT (" << Player::LANDMARK_COUNT << " landmarks)]\n";
+    std::cout << std::left << std::setw(18) << "board" << std::right
+              << std::setw(10) << "terrain" << std::setw(14) << "manhattan" << std::setw(14) << "alt"
+              << std::setw(11) << "reduction" << std::setw(12) << "ms (m/a)" << "\n";
+
+    for(const auto& [name, level] : terrain_boards(levels)){
+        QuerySampler sampler(level, 42);
+        if(!sampler.usable()) continue;
+
+        size_t terrain = 0;
+        for(const Point& p : sampler.cells()){
+            if(level.board[p.x][p.y] == '@' || level.board[p.x][p.y] == '%') ++terrain;
+        }
+
+        //landmarks construídos fora da medição
+        auto tables = std::make_shared<LevelTables>(level);
+        tables->landmarks();
+        Player player(level, tables);
+        size_t nodes[2] = {0, 0};
+        double ms[2] = {0, 0};
+        size_t mismatches = 0;
+
+        for(int k=0;k<pairs;++k){
+            const PathQuery query = sampler.query();
+            int cost[2];
+            for(int alt=0;alt<2;++alt){
+                player.use_landmarks = alt == 1;
+                auto begin = Clock::now();
+                player.computed_path_A(query.start, query.goal);
+                ms[alt] += elapsed_ms(begin);
+                nodes[alt] += player.nodes_expanded;
+                cost[alt] = path_cost(level, player.path);
+            }
+            if(cost[0] != cost[1]) ++mismatches;
+        }
+
+        double reduction = nodes[0] ? 100.0 * (1.0 - (double)nodes[1] / nodes[0]) : 0.0;
+        std::cout << std::left << std::setw(18) << name << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(9) << 100.0 * terrain / sampler.cells().size() << "%"
+                  << std::setw(14) << nodes[0] / pairs << std::setw(14) << nodes[1] / pairs
+                  << std::setw(10) << reduction << "%"
+                  << std::setw(6) << ms[0] << "/" << ms[1] << "\n";
+        if(mismatches){
+            std::cout << "  ! " << mismatches << " paths with different costs\n";
+        }
+    }
+}
@@ -16,7 +16,7 @@
 
 void Level::find_start_position(){
     for(int i=0;i<rows;++i){
-        for(int j=0;j<cols;++j){
+        for(int j=0;j<cols && j<(int)board[i].size();++j){
             if(board[i][j] == '&'){
                 start_mouse = {i, j};
             }else if(board[i][j] == '@'){
@@ -34,42 +34,68 @@ void Level::find_start_position(){
 /**
  * @brief Generates food on a random empty space of the board.
  * 
- * Scans the board for empty spaces and places the food marker '*' at
- * a randomly chosen available location.
+ * Counts the empty spaces (cells past the end of a short row are walls,
+ * not spaces) and places the food marker '*' at a randomly
+ * chosen one, found on a second scan, so no list of spaces is allocated.
  *
- * @details Uses a random number generator to select the position.
+ * @param generator Random number generator that selects the position; the
+ * caller owns it, so equal seeds give equal food positions.
  */
 
-void Level::generate_food(){
+void Level::generate_food(std::mt19937& generator){
     //verificando espaços vazios
-    std::vector<Point> empty_spaces;
+    int empty_count = 0;
     for(int i=0;i<rows;++i){
         for(int j=0;j<cols;++j){
-            if(board[i][j] == ' '){
-                empty_spaces.push_back({i, j});
+            if(j < (int)board[i].size() && board[i][j] == ' '){
+                ++empty_count;
             }
         }
     }
 
     //gerando a comida aleatoriamente em um espaço vazio do tabuleiro verificado anteriormente
-    if(!empty_spaces.empty()){
-        std::random_device rd;
-        std::mt19937 generator(rd());
-        std::uniform_int_distribution<> distribution(0, empty_spaces.size() - 1);
+    if(empty_count > 0){
+        std::uniform_int_distribution<> distribution(0, empty_count - 1);
 
-        // Escolhe um índice aleatório da nossa lista de locais vazios
+        // Escolhe um índice aleatório entre os locais vazios
         int random_index = distribution(generator);
-        
-        // Pega a coordenada correspondente
-        food_mouse = empty_spaces[random_index];
 
-        //Coloca a comida no tabuleiro
-        board[food_mouse.x][food_mouse.y] = '*'; // Usando '*' para representar a comida
+        // Pega a coordenada correspondente e coloca a comida no tabuleiro
+        for(int i=0;i<rows;++i){
+            for(int j=0;j<cols;++j){
+                if(j < (int)board[i].size() && board[i][j] == ' ' && random_index-- == 0){
+                    food_mouse = {i, j};
+                    board[i][j] = '*'; // Usando '*' para representar a comida
+                    return;
+                }
+            }
+        }
     }
 
 }
 
 
+/**
+ * @brief Places several food pellets on the board at once.
+ * 
+ * Used by the all-food mode, where every pellet of the level is on the
+ * board from the start and the mouse must collect them all.
+ *
+ * @param amount Number of pellets; stops early if the board runs out of empty cells.
+ * @param generator Random number generator that selects the positions.
+ */
+
+void Level::generate_all_food(size_t amount, std::mt19937& generator){
+    for(size_t i=0;i<amount;++i){
+        Point previous = food_mouse;
+        generate_food(generator);
+        if(i > 0 && food_mouse == previous){
+            break;
+        }
+    }
+}
+
+
 /**
  * @brief Resets the level's board to its initial state.
  * 
@@ -81,7 +107,7 @@ void Level::generate_food(){
 
 void Level::reset_level(bool initial_level){
     for(int i=0;i<rows;++i){
-        for(int j=0;j<cols;++j){
+        for(int j=0;j<cols && j<(int)board[i].size();++j){
             if(board[i][j] != '#' && board[i][j] != '@' && board[i][j] != '%' && board[i][j] != '.' && board[i][j] != '*'){
                 board[i][j] = ' ';
             }
@@ -109,7 +135,7 @@ void Level::reset_level(bool initial_level){
 
 void Level::fill_data(Point head, bool dead){
     for(int i=0;i<rows;++i){
-        for(int j=0;j<cols;++j){
+        for(int j=0;j<cols && j<(int)board[i].size();++j){
             for(auto m : medium_dificulty){
                 if(m.x == i && m.y == j){
                     board[i][j] = '%';
@@ -138,10 +164,14 @@ void Level::fill_data(Point head, bool dead){
  * 
  * @param level Reference to the level.
  * @param p Coordinates of the cell.
- * @return Character at the specified position.
+ * @return Character at the specified position; '#' outside the board or
+ * past the end of a short row, as in is_open_cell.
  */
 
 char Level::get_cell(const Level& level, const Point& p) {
+    if(p.x < 0 || p.y < 0 || p.x >= level.rows || p.y >= (int)level.board[p.x].size()){
+        return '#';
+    }
     return level.board[p.x][p.y];
 }
 
@@ -178,4 +208,19 @@ bool Level::is_food(char cell) {
 void Level::update_board_after_food() {
     // remove a comida anterior da cabeça da cobra
     board[current_mouse.x][current_mouse.y] = ' ';
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Gets the cost of entering a cell.
+ * 
+ * @param cell Character representing a cell.
+ * @return 10 for high difficulty terrain ('@'), 5 for medium difficulty ('%'), 1 otherwise.
+ */
+
+int Level::terrain_cost(char cell) const {
+    switch (cell) {
+        case '@': return 10; // High difficulty
+        case '%': return 5;  // Medium difficulty
+        default:  return 1;  // Normal ground
+    }
+}
@@ -2,16 +2,17 @@
 #define LEVEL_HPP
 
 #include <vector>
-#include <iostream>
 #include <string>
+#include <random>
 
 #include "direction.hpp"
+#include "grid.hpp"
 
 class Level {
     public:
         int rows;
         int cols;
-        std::vector<std::string> board;
+        Grid board;
         std::vector<Point> medium_dificulty;
         std::vector<Point> high_dificulty;
         int food_increment=0;
@@ -22,7 +23,8 @@ class Level {
         Level() : rows(0), cols(0) {}
 
         void find_start_position();
-        void generate_food();
+        void generate_food(std::mt19937& generator);
+        void generate_all_food(size_t amount, std::mt19937& generator);
         void reset_level(bool initial_level);
         void fill_data(Point head, bool dead);
        
@@ -32,8 +34,9 @@ class Level {
         //bool is_snake_body(char cell);
         bool is_food(char cell);
         bool is_wall(char cell);
+        int terrain_cost(char cell) const;
         
-        const std::vector<std::string>& get_board() const;
+        const Grid& get_board() const;
         void update_board_after_food();
         Point get_mouse_start_position() const; 
         
@@ -0,0 +1,251 @@
+#include "level_reader.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <thread>
+#include <utility>
+
+/**
+ * @brief Reads the dimensions and the board lines of the next level.
+ *
+ * A level is a "rows cols" line followed by `rows` lines of board. The
+ * lines are only split off the file and kept as text in `record.lines`;
+ * building the board (decode_level) and checking it (validate_level) are
+ * left to the caller, so the (serial) reading of the file stays as short
+ * as possible.
+ *
+ * @param in Stream positioned at the start of a level.
+ * @return A SCANNED record; END_OF_FILE when there is no level left, or
+ * INVALID_DIMENSIONS, after which the file cannot be read any further.
+ */
+
+LevelRecord scan_level(std::istream& in){
+    LevelRecord record;
+    int rows, cols;
+
+    if(!(in >> rows >> cols)){
+        return record;
+    }
+
+    if(rows <= 0 || cols<=0 || rows>100 || cols > 100 ){
+        record.status = ReadStatus::INVALID_DIMENSIONS;
+        record.messages = "\nINVALID DIMENSIONS!\n";
+        return record;
+    }
+
+    // Ignora o resto da linha de dimensões para começar a leitura do tabuleiro
+    in.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+
+    record.level.rows = rows;
+    record.level.cols = cols;
+    record.lines.resize(rows);
+    for (int i = 0; i < rows; ++i) {
+        std::getline(in, record.lines[i]);
+    }
+
+    record.status = ReadStatus::SCANNED;
+    return record;
+}
+
+/**
+ * @brief Builds the board of a scanned level from its lines.
+ *
+ * Fills the Grid row by row and compacts it, then frees the lines. Does
+ * nothing when the record is not SCANNED or was already decoded, so it is
+ * safe to call from validate_level.
+ *
+ * @param record Level returned by scan_level.
+ */
+
+void decode_level(LevelRecord& record){
+    if(record.status != ReadStatus::SCANNED || !record.level.board.empty()){
+        return;
+    }
+
+    Level& level = record.level;
+    level.board.resize(level.rows);
+    for (int i = 0; i < level.rows; ++i) {
+        level.board.set_row(i, record.lines[i]);
+    }
+    level.board.compact(); //blocos de borda que ficaram só com parede ou só com chão
+    std::vector<std::string>().swap(record.lines);
+}
+
+/**
+ * @brief Decodes, validates and preprocesses a scanned level.
+ *
+ * The board is built first (decode_level) if it was not yet. A level is valid when it only uses allowed symbols and has exactly one
+ * spawn point ('&'). Valid levels also get their start position and
+ * terrain cells located, so that is not done when the level starts.
+ * Records that were not SCANNED are left untouched.
+ *
+ * @param record Level returned by scan_level; ends up LOADED or SKIPPED.
+ */
+
+void validate_level(LevelRecord& record){
+    if(record.status != ReadStatus::SCANNED){
+        return;
+    }
+    decode_level(record);
+
+    Level& level = record.level;
+    int spawn_point_count = 0; //quantidade de &
+    bool valid_nivel=true;
+
+    for (int i = 0; i < level.rows && valid_nivel; ++i) {
+        // Conta os pontos de spawn na linha
+        for (size_t j = 0; j < level.board[i].size(); ++j) {
+            char c = level.board[i][j];
+            if (c == '&') {
+                spawn_point_count++;
+            }
+
+            if (!(c == '#' ||c == '@' || c == '%' || c == '&' || c == ' ' || c=='.')) {
+                record.messages += "Error: Invalid character '" + std::string(1, c) + "' found.\n";
+                record.messages += "Level ignored because it contains symbols that are not allowed.\n";
+                valid_nivel = false;
+                break;
+            }
+        }
+    }
+
+    record.status = ReadStatus::SKIPPED;
+    std::string size = std::to_string(level.rows) + "x" + std::to_string(level.cols);
+
+    if(!valid_nivel){
+        return;
+    }
+
+    // Valida o conteúdo do tabuleiro
+    if (spawn_point_count > 1) {
+        record.messages += "Warning: The level " + size + " contains more than one '&'.\n";
+        return;
+    }
+
+    if(spawn_point_count==0){
+        record.messages += "Warning: The level " + size + " does not contain a spawn point ('&').\n";
+        return;
+    }
+
+    level.find_start_position();
+    record.status = ReadStatus::LOADED;
+    record.messages += "Info: Level of " + size + " loaded successfully.\n";
+}
+
+/**
+ * @brief Reads, validates and preprocesses the next level of a level file.
+ *
+ * An invalid level is read to its end and skipped, so the levels after it
+ * are still loaded.
+ *
+ * @param in Stream positioned at the start of a level.
+ * @return The level and the messages to show; END_OF_FILE when there is no
+ * level left.
+ */
+
+LevelRecord read_level(std::istream& in){
+    LevelRecord record = scan_level(in);
+    validate_level(record);
+    return record;
+}
+
+/**
+ * @brief Reads every level of a level file.
+ *
+ * The file is first split serially into levels (dimensions and raw board
+ * lines only); then the boards are built, validated and preprocessed on
+ * worker threads that take the next pending level from a shared counter. Records keep the file
+ * order, so printing their messages in sequence gives the same output as a
+ * serial load. Scanning stops at invalid dimensions, whose record is last.
+ *
+ * @param in Level file.
+ * @param threads Number of worker threads; 0 uses every hardware thread.
+ */
+
+std::vector<LevelRecord> read_all_levels(std::istream& in, unsigned threads){
+    std::vector<LevelRecord> records;
+    for(LevelRecord record = scan_level(in); record.status != ReadStatus::END_OF_FILE; record = scan_level(in)){
+        records.push_back(std::move(record));
+        if(records.back().status == ReadStatus::INVALID_DIMENSIONS){
+            break;
+        }
+    }
+
+    const size_t n = records.size();
+    if(threads == 0){
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threads = std::min<size_t>(threads, std::max<size_t>(n, 1));
+
+    std::atomic<size_t> next_record{0};
+    auto worker = [&](){
+        for(size_t i = next_record++; i < n; i = next_record++){
+            validate_level(records[i]);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for(unsigned t=1;t<threads;++t){
+        pool.emplace_back(worker);
+    }
+    worker();
+    for(auto& thread : pool){
+        thread.join();
+    }
+    return records;
+}
+
+/**
+ * @brief Opens a level file for streaming.
+ *
+ * @param prefetch Whether the level after the current one is read on a
+ * background thread while the current one is played.
+ * @return False if the file could not be opened.
+ */
+
+bool LevelStream::open(const std::string& filename, bool prefetch_levels){
+    file.open(filename);
+    prefetch = prefetch_levels;
+    if(prefetch && file.is_open()){
+        pending = std::async(std::launch::async, &LevelStream::read_valid, this);
+    }
+    return file.is_open();
+}
+
+/**
+ * @brief Takes the next valid level of the file.
+ *
+ * Invalid levels in between are skipped; their messages come first in the
+ * returned record. The status is LOADED, END_OF_FILE or INVALID_DIMENSIONS;
+ * once a record that is not LOADED has been returned (or the file could
+ * not be opened), every later call returns END_OF_FILE.
+ */
+
+LevelRecord LevelStream::next(){
+    if(ended || (prefetch && !pending.valid())){
+        ended = true;
+        return LevelRecord();
+    }
+
+    LevelRecord record = prefetch ? pending.get() : read_valid();
+    //só o próximo nível é lido antes da hora, nunca o arquivo inteiro
+    if(record.status != ReadStatus::LOADED){
+        ended = true;
+    }else if(prefetch){
+        pending = std::async(std::launch::async, &LevelStream::read_valid, this);
+    }
+    return record;
+}
+
+LevelRecord LevelStream::read_valid(){
+    std::string skipped;
+    while(true){
+        LevelRecord record = read_level(file);
+        if(record.status != ReadStatus::SKIPPED){
+            record.messages = std::move(skipped) + record.messages;
+            return record;
+        }
+        skipped += record.messages;
+    }
+}
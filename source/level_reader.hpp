@@ -0,0 +1,65 @@
+#ifndef LEVEL_READER_HPP
+#define LEVEL_READER_HPP
+
+#include <cstdint>
+#include <fstream>
+#include <future>
+#include <istream>
+#include <string>
+#include <vector>
+
+#include "level.hpp"
+
+enum class ReadStatus : std::uint8_t {
+    SCANNED, //tabuleiro lido, ainda não validado
+    LOADED, //nível válido em `level`
+    SKIPPED, //nível com erro, ignorado
+    INVALID_DIMENSIONS, //erro fatal, o arquivo não pode continuar
+    END_OF_FILE
+};
+
+/**
+ * @brief Result of reading one level from a level file.
+ *
+ * The messages that loading prints today (warnings, "Info: ... loaded")
+ * are kept in `messages` so the caller prints them in file order, even
+ * when the level was read on another thread. A SCANNED record holds the
+ * raw board lines in `lines` until decode_level turns them into the board.
+ */
+
+struct LevelRecord {
+    ReadStatus status = ReadStatus::END_OF_FILE;
+    Level level;
+    std::string messages;
+    std::vector<std::string> lines;
+};
+
+LevelRecord scan_level(std::istream& in);
+void decode_level(LevelRecord& record);
+void validate_level(LevelRecord& record);
+LevelRecord read_level(std::istream& in);
+std::vector<LevelRecord> read_all_levels(std::istream& in, unsigned threads = 0);
+
+/**
+ * @brief Reads the levels of a file one at a time.
+ *
+ * Only the level being handed out (and, with prefetching, the one after
+ * it, parsed on a background thread) is in memory, so memory use does not
+ * grow with the number of levels in the file.
+ */
+
+class LevelStream {
+    public:
+        bool open(const std::string& filename, bool prefetch_levels = true);
+        LevelRecord next();
+
+    private:
+        std::ifstream file;
+        bool prefetch = true;
+        std::future<LevelRecord> pending; //próximo nível, lido em segundo plano
+        bool ended = false; //já entregou o fim do arquivo ou um erro fatal
+
+        LevelRecord read_valid();
+};
+
+#endif
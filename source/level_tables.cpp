@@ -0,0 +1,41 @@
+#include "level_tables.hpp"
+#include "level.hpp"
+
+/**
+ * @brief Copy of the level with the terrain restored where a marker (head,
+ * pellet) covers it, used only while a table is built.
+ */
+
+Level LevelTables::terrain() const {
+    Level copy = level;
+    for(const Point& p : copy.medium_dificulty){
+        copy.board[p.x][p.y] = '%';
+    }
+    for(const Point& p : copy.high_dificulty){
+        copy.board[p.x][p.y] = '@';
+    }
+    return copy;
+}
+
+const CorridorGraph& LevelTables::corridors(){
+    if(!corridor_graph){
+        corridor_graph = std::make_unique<CorridorGraph>();
+        corridor_graph->build(terrain());
+    }
+    return *corridor_graph;
+}
+
+const Landmarks& LevelTables::landmarks(){
+    if(!landmark_table){
+        landmark_table = std::make_unique<Landmarks>();
+        landmark_table->build(terrain(), LANDMARK_COUNT);
+    }
+    return *landmark_table;
+}
+
+const SharedBoard& LevelTables::static_board(){
+    if(!board){
+        board = LevelSnapshot::static_board(terrain());
+    }
+    return board;
+}
@@ -0,0 +1,52 @@
+#ifndef LEVEL_TABLES_HPP
+#define LEVEL_TABLES_HPP
+
+#include <memory>
+
+#include "corridor_graph.hpp"
+#include "landmarks.hpp"
+#include "snapshot.hpp"
+
+class Level;
+
+/**
+ * @brief Preprocessed tables of a level that depend only on its walls and
+ * terrain: the corridor graph, the ALT landmarks and the static board of
+ * the Monte Carlo snapshots.
+ *
+ * Each table is built the first time a planner asks for it, so the random
+ * and backtracking players build none, and A* without landmarks builds
+ * only what it uses. Tables are built from the terrain of the level ('@'
+ * and '%' under the head or a pellet are restored first), never change
+ * afterwards and can be shared by every Player of the level, e.g. the games
+ * of a GameLoop. Building is not synchronized: share them on one thread.
+ *
+ * `level` must outlive the tables.
+ */
+
+class LevelTables {
+    public:
+        explicit LevelTables(const Level& level) : level(level) {}
+        LevelTables(const LevelTables&) = delete;
+        LevelTables& operator=(const LevelTables&) = delete;
+
+        static const int LANDMARK_COUNT = 4;
+
+        const CorridorGraph& corridors();
+        const Landmarks& landmarks();
+        const SharedBoard& static_board();
+
+        bool has_corridors() const { return corridor_graph != nullptr; }
+        bool has_landmarks() const { return landmark_table != nullptr; }
+        bool has_static_board() const { return board != nullptr; }
+
+    private:
+        const Level& level;
+        std::unique_ptr<CorridorGraph> corridor_graph;
+        std::unique_ptr<Landmarks> landmark_table;
+        SharedBoard board;
+
+        Level terrain() const;
+};
+
+#endif
@@ -0,0 +1,142 @@
+#include "live_stats.hpp"
+
+#include <cstring>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+static_assert(std::is_trivially_copyable_v<LiveSample>, "LiveSample is copied word by word");
+static_assert(sizeof(LiveSample) % sizeof(std::uint64_t) == 0, "LiveSample must be made of whole words");
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "the segment is shared between processes");
+
+LiveStats::~LiveStats(){
+    if(block != nullptr){
+        munmap(block, sizeof(Block));
+    }
+    if(owner){
+        shm_unlink(name.c_str());
+    }
+}
+
+bool LiveStats::map(const std::string& shm_name, bool create_it){
+    const int fd = shm_open(shm_name.c_str(), create_it ? O_CREAT | O_RDWR : O_RDONLY, 0644);
+    if(fd < 0){
+        return false;
+    }
+    if(create_it && ftruncate(fd, sizeof(Block)) != 0){
+        close(fd);
+        shm_unlink(shm_name.c_str());
+        return false;
+    }
+    void* memory = mmap(nullptr, sizeof(Block), create_it ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+    close(fd); //o mapeamento continua válido
+    if(memory == MAP_FAILED){
+        if(create_it){
+            shm_unlink(shm_name.c_str());
+        }
+        return false;
+    }
+    block = static_cast<Block*>(memory);
+    name = shm_name;
+    owner = create_it;
+    return true;
+}
+
+/**
+ * @brief Creates the segment (replacing one left with the same name) for
+ * this process to publish into.
+ */
+
+bool LiveStats::create(const std::string& shm_name){
+    if(!map(shm_name, true)){
+        return false;
+    }
+    //o ftruncate zerou a memória: sequência par, amostra vazia
+    block->magic.store(MAGIC, std::memory_order_release);
+    return true;
+}
+
+/**
+ * @brief Opens a segment created by another process, read-only.
+ *
+ * @return False if it does not exist or is not a live statistics segment.
+ */
+
+bool LiveStats::attach(const std::string& shm_name){
+    if(!map(shm_name, false)){
+        return false;
+    }
+    if(block->magic.load(std::memory_order_acquire) != MAGIC){
+        munmap(block, sizeof(Block));
+        block = nullptr;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Writes a new sample. Only the creating process may publish.
+ */
+
+void LiveStats::publish(const LiveSample& sample){
+    if(block == nullptr || !owner){
+        return;
+    }
+    std::uint64_t words[WORDS];
+    std::memcpy(words, &sample, sizeof(words));
+
+    const std::uint64_t sequence = block->sequence.load(std::memory_order_relaxed);
+    block->sequence.store(sequence + 1, std::memory_order_relaxed); //ímpar: escrita em andamento
+    std::atomic_thread_fence(std::memory_order_release);
+    for(size_t i=0;i<WORDS;++i){
+        block->words[i].store(words[i], std::memory_order_relaxed);
+    }
+    block->sequence.store(sequence + 2, std::memory_order_release);
+}
+
+/**
+ * @brief Copies the last complete sample.
+ *
+ * @return False if the writer kept changing it during every attempt.
+ */
+
+bool LiveStats::read(LiveSample& sample) const {
+    if(block == nullptr){
+        return false;
+    }
+    const int ATTEMPTS = 1000;
+    std::uint64_t words[WORDS];
+    for(int attempt=0;attempt<ATTEMPTS;++attempt){
+        const std::uint64_t before = block->sequence.load(std::memory_order_acquire);
+        if(before & 1){
+            continue;
+        }
+        for(size_t i=0;i<WORDS;++i){
+            words[i] = block->words[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if(block->sequence.load(std::memory_order_relaxed) == before){
+            std::memcpy(&sample, words, sizeof(words));
+            //texto sempre terminado, mesmo vindo de outro processo
+            sample.state[sizeof(sample.state) - 1] = '\0';
+            sample.planner[sizeof(sample.planner) - 1] = '\0';
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Name used by --stats: "/mouze-<pid>".
+ */
+
+std::string LiveStats::default_name(){
+    return "/mouze-" + std::to_string(getpid());
+}
+
+void LiveStats::copy_text(char (&out)[16], const char* text){
+    std::strncpy(out, text, sizeof(out) - 1);
+    out[sizeof(out) - 1] = '\0';
+}
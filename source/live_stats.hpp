@@ -0,0 +1,80 @@
+#ifndef LIVE_STATS_HPP
+#define LIVE_STATS_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Counters of a running simulation, as seen by a viewer.
+ *
+ * Plain data, copied in 8-byte words; the strings are cut to fit and
+ * always end in '\0'.
+ */
+
+struct LiveSample {
+    std::uint64_t pid = 0;
+    std::uint64_t ticks = 0; //voltas do laço de jogo
+    std::uint64_t score = 0;
+    std::uint64_t lives = 0;
+    std::uint64_t level = 0; //índice do nível atual, a partir de 0
+    std::uint64_t eaten = 0;
+    std::uint64_t food = 0;
+    std::uint64_t think_ns_last = 0; //duração do último passo THINKING
+    std::uint64_t think_ns_total = 0;
+    std::uint64_t think_calls = 0;
+    char state[16] = {};
+    char planner[16] = {};
+};
+
+/**
+ * @brief Shared-memory segment with the LiveSample of one simulation.
+ *
+ * The simulation opens it with `create` and calls `publish` once per tick;
+ * viewers (see tools/mouze_top.cpp) open it with `attach` and call `read`
+ * at their own pace. The sample is guarded by a seqlock: the writer makes
+ * the sequence odd, stores the words and makes it even again, and a
+ * reader retries when the sequence was odd or changed while it copied.
+ * Publishing takes no lock and makes no system call, so it costs a few
+ * relaxed stores; the writer never waits for readers.
+ *
+ * Names are POSIX shared-memory names (e.g. "/mouze-1234"); the segment is
+ * removed when the creating object is destroyed.
+ */
+
+class LiveStats {
+    public:
+        LiveStats() = default;
+        ~LiveStats();
+        LiveStats(const LiveStats&) = delete;
+        LiveStats& operator=(const LiveStats&) = delete;
+
+        bool create(const std::string& name);
+        bool attach(const std::string& name);
+        bool is_open() const { return block != nullptr; }
+        const std::string& get_name() const { return name; }
+
+        void publish(const LiveSample& sample);
+        bool read(LiveSample& sample) const;
+
+        static std::string default_name();
+        static void copy_text(char (&out)[16], const char* text);
+
+    private:
+        static constexpr std::uint64_t MAGIC = 0x3154534d5a554f4dull; //"MOUZMST1"
+        static constexpr size_t WORDS = sizeof(LiveSample) / sizeof(std::uint64_t);
+
+        struct Block {
+            std::atomic<std::uint64_t> magic;
+            std::atomic<std::uint64_t> sequence;
+            std::atomic<std::uint64_t> words[WORDS];
+        };
+
+        Block* block = nullptr;
+        std::string name;
+        bool owner = false;
+
+        bool map(const std::string& shm_name, bool create_it);
+};
+
+#endif
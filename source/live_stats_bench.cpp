@@ -0,0 +1,50 @@
+#include "benchmark.hpp"
+#include "live_stats.hpp"
+
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+
+/**
+ * @brief Cost of publishing the live statistics of one tick (--stats)
+ * and of a viewer reading them, with a segment of this process.
+ */
+
+void bench_stats(){
+    const int rounds = 2000000;
+    std::cout << "\n[LIVE STATISTICS (" << rounds << " samples)]\n";
+
+    LiveStats writer;
+    if(!writer.create(LiveStats::default_name() + "-bench")){
+        std::cout << "  ! shared memory not available\n";
+        return;
+    }
+    LiveStats reader;
+    reader.attach(writer.get_name());
+
+    LiveSample sample;
+    LiveStats::copy_text(sample.planner, "A*");
+    auto begin = Clock::now();
+    for(int k=0;k<rounds;++k){
+        //o mesmo trabalho de MouzeSimulation::publish_stats
+        ++sample.ticks;
+        sample.score += 5;
+        LiveStats::copy_text(sample.state, k % 2 ? "RUNNING" : "THINKING");
+        writer.publish(sample);
+    }
+    double publish_ns = elapsed_ms(begin) * 1e6 / rounds;
+
+    LiveSample seen;
+    size_t failed = 0;
+    begin = Clock::now();
+    for(int k=0;k<rounds;++k){
+        failed += !reader.read(seen);
+    }
+    double read_ns = elapsed_ms(begin) * 1e6 / rounds;
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "  publish: " << publish_ns << " ns/tick, read: " << read_ns << " ns (" << sizeof(LiveSample) << " bytes)\n";
+    if(failed || seen.ticks != (std::uint64_t)rounds){
+        std::cout << "  ! reader saw " << seen.ticks << " ticks, " << failed << " failed reads\n";
+    }
+}
@@ -0,0 +1,67 @@
+#include "maze.hpp"
+
+#include <algorithm>
+#include <random>
+#include <stack>
+
+Level generate_maze(int rows, int cols, unsigned seed, int loop_percent, int terrain_percent){
+    Level level;
+    level.rows = rows;
+    level.cols = cols;
+    level.board.assign(rows, std::string(cols, '#'));
+
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<> percent(0, 99);
+
+    //DFS nas células ímpares, derrubando a parede entre a célula e o vizinho
+    std::stack<Point> to_visit;
+    level.board[1][1] = ' ';
+    to_visit.push({1, 1});
+
+    while(!to_visit.empty()){
+        Point current = to_visit.top();
+        Point options[4];
+        int count = 0;
+
+        for(const Point& move : MOVES){
+            Point next{current.x + 2 * move.x, current.y + 2 * move.y};
+            if(next.x > 0 && next.y > 0 && next.x < rows - 1 && next.y < cols - 1 && level.board[next.x][next.y] == '#'){
+                options[count++] = next;
+            }
+        }
+
+        if(count == 0){
+            to_visit.pop();
+            continue;
+        }
+
+        Point next = options[std::uniform_int_distribution<>(0, count - 1)(gen)];
+        level.board[(current.x + next.x) / 2][(current.y + next.y) / 2] = ' ';
+        level.board[next.x][next.y] = ' ';
+        to_visit.push(next);
+    }
+
+    //abre paredes internas para criar ciclos
+    for(int i=1;i<rows-1;++i){
+        for(int j=1;j<cols-1;++j){
+            if(level.board[i][j] != '#' || percent(gen) >= loop_percent) continue;
+            bool vertical = level.board[i-1][j] != '#' && level.board[i+1][j] != '#';
+            bool horizontal = level.board[i][j-1] != '#' && level.board[i][j+1] != '#';
+            if(vertical != horizontal){
+                level.board[i][j] = ' ';
+            }
+        }
+    }
+
+    for(int i=1;i<rows-1;++i){
+        for(int j=1;j<cols-1;++j){
+            if(level.board[i][j] == ' ' && percent(gen) < terrain_percent){
+                level.board[i][j] = percent(gen) < 50 ? '@' : '%';
+            }
+        }
+    }
+
+    level.board[1][1] = '&';
+    level.find_start_position();
+    return level;
+}
@@ -0,0 +1,24 @@
+#ifndef MAZE_HPP
+#define MAZE_HPP
+
+#include "level.hpp"
+
+/**
+ * @brief Generates a random maze level for benchmarks.
+ *
+ * Carves a perfect maze on the odd cells with a depth-first search, opens a
+ * share of the remaining inner walls to create loops and sprinkles
+ * high ('@') and medium ('%') difficulty terrain over the open cells. The
+ * spawn point '&' is placed at (1, 1).
+ *
+ * @param rows Number of rows (at least 3).
+ * @param cols Number of columns (at least 3).
+ * @param seed Seed of the random generator, so mazes are reproducible.
+ * @param loop_percent Chance (0-100) of removing each inner wall left.
+ * @param terrain_percent Chance (0-100) of an open cell getting terrain.
+ * @return The generated level, with its start position already found.
+ */
+
+Level generate_maze(int rows, int cols, unsigned seed, int loop_percent = 10, int terrain_percent = 0);
+
+#endif
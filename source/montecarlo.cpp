@@ -0,0 +1,196 @@
+#include "montecarlo.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+
+/**
+ * @brief Starts the worker threads.
+ *
+ * @param threads Total number of threads doing rollouts, including the
+ * caller of best_move; 0 uses every hardware thread.
+ */
+
+RolloutEngine::RolloutEngine(unsigned threads){
+    if(threads == 0){
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    std::random_device rd;
+    for(unsigned id=0;id<threads;++id){
+        generators.emplace_back(rd());
+    }
+    totals.resize(threads);
+    for(unsigned id=1;id<threads;++id){
+        workers.emplace_back(&RolloutEngine::worker_loop, this, id);
+    }
+}
+
+RolloutEngine::~RolloutEngine(){
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    work_ready.notify_all();
+    for(auto& worker : workers){
+        worker.join();
+    }
+}
+
+/**
+ * @brief Chooses the next move of the mouse.
+ *
+ * Runs `rollouts_per_move` rollouts for each direction that is not a wall
+ * and returns the one with the best mean value.
+ *
+ * @param snapshot Current state; it is only read.
+ * @param rollouts_per_move Rollouts for each candidate move.
+ * @param depth Maximum number of moves of a rollout.
+ */
+
+Dir RolloutEngine::best_move(const LevelSnapshot& snapshot, int rollouts_per_move, int depth){
+    candidate_count = 0;
+    for(Dir d : {Dir::N, Dir::S, Dir::L, Dir::O}){
+        Point next{snapshot.head.x + MOVES[d].x, snapshot.head.y + MOVES[d].y};
+        if(snapshot.get(next) != '#'){
+            candidates[candidate_count++] = d;
+        }
+    }
+    if(candidate_count == 0) return Dir::N;
+    if(candidate_count == 1) return candidates[0];
+
+    auto begin = std::chrono::steady_clock::now();
+    root = &snapshot;
+    rollout_total = rollouts_per_move * candidate_count;
+    rollout_depth = depth;
+    next_rollout = 0;
+    for(Totals& t : totals){
+        t = Totals{};
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++generation;
+        busy = workers.size();
+    }
+    work_ready.notify_all();
+    run_rollouts(0);
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        work_done.wait(lock, [this]{ return busy == 0; });
+    }
+
+    int best = 0;
+    double best_mean = 0;
+    for(int c=0;c<candidate_count;++c){
+        double value = 0;
+        int count = 0;
+        for(const Totals& t : totals){
+            value += t.value[c];
+            count += t.count[c];
+        }
+        double mean = count ? value / count : 0;
+        if(c == 0 || mean > best_mean){
+            best = c;
+            best_mean = mean;
+        }
+    }
+
+    rollouts_done += rollout_total;
+    seconds_spent += std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    return candidates[best];
+}
+
+void RolloutEngine::worker_loop(unsigned id){
+    size_t seen = 0;
+    while(true){
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            work_ready.wait(lock, [&]{ return stopping || generation != seen; });
+            if(stopping) return;
+            seen = generation;
+        }
+        run_rollouts(id);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if(--busy == 0){
+                work_done.notify_one();
+            }
+        }
+    }
+}
+
+/**
+ * @brief Takes rollouts from the shared counter until none is left.
+ */
+
+void RolloutEngine::run_rollouts(unsigned id){
+    for(int k = next_rollout++; k < rollout_total; k = next_rollout++){
+        int c = k % candidate_count;
+        totals[id].value[c] += rollout(id, candidates[c]);
+        totals[id].count[c] += 1;
+    }
+}
+
+/**
+ * @brief Plays one random game from the root snapshot.
+ *
+ * After the first move, each step picks a random direction that is not a
+ * wall, avoiding going straight back when there is another option.
+ *
+ * @return 100 plus the moves left when a pellet is eaten (sooner is better),
+ * -100 on a crash, otherwise minus the normalized distance to the closest
+ * pellet at the end.
+ */
+
+double RolloutEngine::rollout(unsigned id, Dir first){
+    LevelSnapshot state = *root;
+    std::mt19937& gen = generators[id];
+    Dir previous = first;
+
+    for(int t=0;t<rollout_depth;++t){
+        Dir d = first;
+        if(t > 0){
+            Dir options[4];
+            int count = 0;
+            Dir back = static_cast<Dir>(previous ^ 1);
+            for(Dir option : {Dir::N, Dir::S, Dir::L, Dir::O}){
+                Point next{state.head.x + MOVES[option].x, state.head.y + MOVES[option].y};
+                if(option != back && state.get(next) != '#'){
+                    options[count++] = option;
+                }
+            }
+            //beco: a única saída é voltar
+            d = count ? options[std::uniform_int_distribution<int>(0, count - 1)(gen)] : back;
+        }
+
+        if(!state.step(d)){
+            return -100.0;
+        }
+        if(state.food_eaten > root->food_eaten){
+            return 100.0 + (rollout_depth - t);
+        }
+        previous = d;
+    }
+
+    Point food;
+    if(state.nearest_food(food)){
+        return -(double)(std::abs(food.x - state.head.x) + std::abs(food.y - state.head.y)) / (state.rows + state.cols);
+    }
+    return 0;
+}
+
+unsigned RolloutEngine::thread_count() const{
+    return generators.size();
+}
+
+size_t RolloutEngine::total_rollouts() const{
+    return rollouts_done;
+}
+
+/**
+ * @brief Rollout throughput over every best_move call so far.
+ */
+
+double RolloutEngine::rollouts_per_second() const{
+    return seconds_spent > 0 ? rollouts_done / seconds_spent : 0;
+}
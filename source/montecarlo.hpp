@@ -0,0 +1,69 @@
+#ifndef MONTECARLO_HPP
+#define MONTECARLO_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "snapshot.hpp"
+
+/**
+ * @brief Flat Monte Carlo move evaluation over a pool of threads.
+ *
+ * Every valid first move is scored by the mean value of many random
+ * rollouts started from a copy of the current snapshot. Rollouts are shared
+ * out to persistent worker threads (the calling thread also works), each one
+ * with its own random generator and accumulators, so a call does not touch
+ * the heap nor create threads.
+ */
+
+class RolloutEngine {
+    public:
+        explicit RolloutEngine(unsigned threads = 0);
+        ~RolloutEngine();
+        RolloutEngine(const RolloutEngine&) = delete;
+        RolloutEngine& operator=(const RolloutEngine&) = delete;
+
+        Dir best_move(const LevelSnapshot& root, int rollouts_per_move, int depth);
+
+        unsigned thread_count() const;
+        size_t total_rollouts() const;
+        double rollouts_per_second() const;
+
+    private:
+        struct alignas(64) Totals { //um por thread, em linhas de cache separadas
+            double value[4];
+            int count[4];
+        };
+
+        std::vector<std::thread> workers;
+        std::vector<std::mt19937> generators;
+        std::vector<Totals> totals;
+
+        std::mutex mutex;
+        std::condition_variable work_ready;
+        std::condition_variable work_done;
+        size_t generation = 0;
+        unsigned busy = 0;
+        bool stopping = false;
+
+        //trabalho da chamada atual
+        const LevelSnapshot* root = nullptr;
+        Dir candidates[4];
+        int candidate_count = 0;
+        int rollout_total = 0;
+        int rollout_depth = 0;
+        std::atomic<int> next_rollout{0};
+
+        size_t rollouts_done = 0;
+        double seconds_spent = 0;
+
+        void worker_loop(unsigned id);
+        void run_rollouts(unsigned id);
+        double rollout(unsigned id, Dir first);
+};
+
+#endif
@@ -0,0 +1,70 @@
+#include "benchmark.hpp"
+#include "alloc_counter.hpp"
+#include "maze.hpp"
+#include "montecarlo.hpp"
+#include "player.hpp"
+#include "snapshot.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+/**
+ * @brief Measures snapshot copies and rollout throughput.
+ *
+ * Plays Monte Carlo moves towards a pellet on a generated maze with one
+ * thread and with every hardware thread, and reports rollouts per second
+ * and the number of moves needed against the shortest path.
+ */
+
+void bench_rollout(){
+    const unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    Level maze = generate_maze(41, 41, 6, 25, 0);
+    SharedBoard board = LevelSnapshot::static_board(maze);
+
+    Point food = QuerySampler(maze, 11).cell();
+    maze.board[food.x][food.y] = '*';
+
+    LevelSnapshot root = LevelSnapshot::capture(board, maze, maze.start_mouse, 0, 5);
+    const int copies = 1000000;
+    size_t allocations = allocation_count();
+    auto begin = Clock::now();
+    size_t checksum = 0;
+    for(int k=0;k<copies;++k){
+        LevelSnapshot copy = root;
+        checksum += copy.get(food);
+    }
+    double copy_ns = elapsed_ms(begin) * 1e6 / copies;
+    allocations = allocation_count() - allocations;
+
+    std::cout << "\n[MONTE CARLO ROLLOUTS ON MAZE 41x41]\n";
+    std::cout << "  snapshot copy: " << std::fixed << std::setprecision(1) << copy_ns << " ns, ";
+    if(has_allocation_count()){
+        std::cout << allocations << " allocations";
+    }else{
+        std::cout << "allocations not counted";
+    }
+    std::cout << " in " << copies << " copies (" << checksum % 2 << ")\n";
+    std::cout << std::setw(10) << "threads" << std::setw(16) << "rollouts/s" << std::setw(10) << "moves"
+              << std::setw(12) << "shortest" << "\n";
+
+    Player player(maze);
+    player.use_landmarks = false;
+    player.computed_path_A(maze.start_mouse, food);
+    size_t shortest = player.path.size();
+
+    for(unsigned t : {1u, threads}){
+        RolloutEngine engine(t);
+        LevelSnapshot state = root;
+        int moves = 0;
+        const int limit = 20 * (int)shortest + 100;
+        while(state.food_eaten == 0 && moves < limit){
+            state.step(engine.best_move(state, Player::ROLLOUTS_PER_MOVE, maze.rows + maze.cols));
+            ++moves;
+        }
+        std::cout << std::setw(10) << t << std::setw(16) << std::setprecision(0) << engine.rollouts_per_second()
+                  << std::setw(10) << moves << std::setw(12) << shortest << "\n";
+        if(t == threads) break;
+    }
+}
@@ -3,33 +3,69 @@
 
 #include "output.hpp"
 #include "simulation.hpp"
+#include "planner.hpp"
+#include "embedded_levels.hpp"
 
 void MouzeSimulation::help_screen(std::string_view msg){
     if(!msg.empty()){
         std::cout<<"Error: "<<msg<<"\n\n"; //mensagem de erro que será chamada na validação dos argumentos
     }
-    std::cout << "Usage: mouze [<options>] <input_level_file>\n\n";
+    std::cout << "Usage: mouze [<options>] <input_level_file>\n";
+    if(has_embedded_levels()){
+        std::cout << "Without <input_level_file> the levels embedded in this build are played.\n";
+    }
+    std::cout << "\n";
     std::cout << "Game simulation options:\n";
     std::cout << "  --help           Print this help text.\n";
     std::cout << "  --fps <num>      Number of frames (board) presented per second.\n";
     std::cout << "  --lives <num>    Number of lives the snake shall have. Default = 5.\n";
     std::cout << "  --food <num>     Number of food pellets for the entire simulation. Default = 10.\n";
-    std::cout << "  --playertype <type> Type of snake intelligence: random, backtracking ou A*. Default = A*.\n";
+    std::cout << "  --playertype <type> Type of snake intelligence: " << planner_names() << ". Default = A*.\n";
+    std::cout << "  --budget <us>    Search time per tick of the ARA* player, in microseconds (0 = no limit). Default = 2000.\n";
+    std::cout << "  --ida-table <num> Transposition table entries of the IDA* player (0 = none). Default = 4096.\n";
+    std::cout << "  --cache <num>    Keep up to this many planned paths (LRU) and reuse them for repeated start/food pairs (0 = off). Default = 0.\n";
+    std::cout << "  --allfood        Place every food pellet of the level at once (implied by the tour player).\n";
+    std::cout << "  --stream         Read the levels one at a time while playing instead of loading the whole file.\n";
+    std::cout << "  --trace <file>   Write a Chrome trace of states and planner calls (needs a build with -DMOUZE_TRACE).\n";
+    std::cout << "  --stats          Publish score, lives, ticks, level and planner time to shared memory /mouze-<pid> for mouze-top.\n";
+    std::cout << "  --serve <socket>  Answer path queries on the loaded levels over a Unix socket ('-' for stdin/stdout) instead of playing.\n";
+    std::cout << "  --games <num>    Play this many games at once on one thread, without drawing, and print how they ended (needs a C++20 build).\n";
+    std::cout << "  --build-db       Precompute the path database of the levels (first move between every two cells) into a .cpd file next to the .dat, used by --serve, and exit.\n";
+    std::cout << "  --layout <order>  Cell order of the --serve planners: 'row' (row-major) or 'morton' (Z-order).\n";
+    std::cout << "  --bench <name>   Run a planner benchmark (alt, tour, alloc, rollout, hda, field, batch, cpd, cache, ida, stats, layout, route, anytime, grid, verify or all) on the loaded and generated levels and exit.\n";
+    std::cout << "  --baseline <file> Results file compared by --bench verify (which also plays the other .dat files next to the level file); written if it does not exist.\n";
+}
+
+/**
+ * @brief Copies the board and the status line into a frame for the render thread.
+ *
+ * Does not wait for the terminal; see FrameRenderer.
+ */
+
+void MouzeSimulation::render_board(const Level& level_to_draw) {
+    Frame& frame = frames.back();
+    frame.lives = player->lives;
+    frame.eaten = player->get_mouse_size();
+    frame.food = food;
+    level_to_draw.board.copy_to(frame.board); //reaproveita a memória do quadro anterior
+    frames.submit();
 }
 
-void MouzeSimulation::render_board(const Level& level_to_draw) {   
-    std::vector<std::string> temp_board = level_to_draw.board; // cópia local
+/**
+ * @brief Draws a frame, writing it to the stream in a single call.
+ */
 
-    std::cout << "---------------------- MouzeAi -----------------------\n";
-    std::cout << "Lives: ";
-    for(size_t i = 0; i < player->lives; ++i){
-        std::cout << "❤️ ";
+void draw_frame(const Frame& frame, std::ostream& out){
+    std::string text = "---------------------- MouzeAi -----------------------\n";
+    text += "Lives: ";
+    for(size_t i = 0; i < frame.lives; ++i){
+        text += "❤️ ";
     }
-    std::cout << " Food: " << player->get_mouse_size() << " de " << food << "\n";
-    std::cout << "----------------------------------------------------\n";
+    text += " Food: " + std::to_string(frame.eaten) + " de " + std::to_string(frame.food) + "\n";
+    text += "----------------------------------------------------\n";
 
     //definir oq cada item é visualmente
-    const std::map<char, std::string> emojis = {
+    static const std::map<char, std::string> emojis = {
         //colocar o outro tipo de mapa
         {'#', "🌳"},
         {'&', "🐭"},
@@ -41,16 +77,18 @@ void MouzeSimulation::render_board(const Level& level_to_draw) {
     };
 
     //imprimir caracter por caracter
-    for (const auto& line : temp_board) {
+    for (const auto& line : frame.board) {
         for(const char c : line){
-            if(emojis.count(c)){
-                std::cout << emojis.at(c);
+            auto emoji = emojis.find(c);
+            if(emoji != emojis.end()){
+                text += emoji->second;
             }else{
-                std::cout << "  ";
+                text += "  ";
             }
         }
-        std::cout << "\n";
+        text += "\n";
     }
+    out << text << std::flush;
 }
 
 void MouzeSimulation::run_tests() {
@@ -64,6 +102,9 @@ void MouzeSimulation::run_tests() {
     std::cout << "  > Lives: " << lives << "\n";
     std::cout << "  > Foods: " << food << "\n";
     std::cout << "  > Type of AI: '" << player_type << "'\n";
+    std::cout << "  > Planning budget: " << plan_budget_us << " us\n";
+    std::cout << "  > IDA* table: " << ida_table_size << " entries\n";
+    std::cout << "  > Path cache: " << cache_capacity << " paths\n";
 
 
     std::cout << "\n=================================================\n";
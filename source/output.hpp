@@ -2,11 +2,14 @@
 #define OUTPUT_HPP
 
 #include "level.hpp"
+#include "frame_renderer.hpp"
 
 #include <map>
+#include <ostream>
 
 void help_screen(std::string_view msg="");
 void render_board(const Level& level_to_draw);
 void run_tests();
+void draw_frame(const Frame& frame, std::ostream& out);
 
 #endif
\ No newline at end of file
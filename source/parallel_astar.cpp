@@ -0,0 +1,250 @@
+#include "parallel_astar.hpp"
+#include "level.hpp"
+#include "search.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <queue>
+#include <thread>
+
+namespace {
+    const int BLOCK_BITS = 3; //células de um bloco 8x8 ficam na mesma thread
+    const size_t QUEUE_SIZE = 1 << 12; //mensagens por fila (potência de 2)
+    const int EXPANSIONS_PER_ROUND = 64; //entre uma leitura das filas e outra
+
+    struct Message {
+        int cell;
+        int g;
+        int parent;
+    };
+
+    /**
+     * @brief Lock-free ring buffer with one producer and one consumer thread.
+     */
+
+    struct MessageQueue {
+        std::unique_ptr<Message[]> slots{new Message[QUEUE_SIZE]};
+        alignas(64) std::atomic<size_t> head{0}; //lido pelo consumidor
+        alignas(64) std::atomic<size_t> tail{0}; //escrito pelo produtor
+
+        bool push(const Message& message){
+            const size_t t = tail.load(std::memory_order_relaxed);
+            if(t - head.load(std::memory_order_acquire) == QUEUE_SIZE){
+                return false;
+            }
+            slots[t & (QUEUE_SIZE - 1)] = message;
+            tail.store(t + 1, std::memory_order_release);
+            return true;
+        }
+
+        bool pop(Message& message){
+            const size_t h = head.load(std::memory_order_relaxed);
+            if(h == tail.load(std::memory_order_acquire)){
+                return false;
+            }
+            message = slots[h & (QUEUE_SIZE - 1)];
+            head.store(h + 1, std::memory_order_release);
+            return true;
+        }
+    };
+
+    struct Entry {
+        int f;
+        int g;
+        int cell;
+
+        //menor f primeiro; no empate, o mais fundo (maior g)
+        bool operator>(const Entry& other) const {
+            return f != other.f ? f > other.f : g < other.g;
+        }
+    };
+
+    /**
+     * @brief State shared by the threads of one search.
+     *
+     * `g` and `parent` are shared arrays, but each cell is only read and
+     * written by the thread that owns it until the threads are joined.
+     */
+
+    struct Search {
+        const Level& level;
+        int cols;
+        Point goal;
+        unsigned threads;
+        std::vector<int> g;
+        std::vector<int> parent;
+        std::unique_ptr<MessageQueue[]> queues; //[de * threads + para]
+
+        std::atomic<int> best{UNREACHABLE};
+        std::atomic<long> in_flight{0}; //mensagens enviadas e ainda não contabilizadas pelo destino
+        std::atomic<unsigned> idle{0};
+        std::atomic<bool> done{false};
+        std::atomic<size_t> expanded{0};
+        std::atomic<size_t> messages{0};
+
+        Search(const Level& lvl, Point target, unsigned thread_count)
+            : level(lvl), cols(lvl.cols), goal(target), threads(thread_count),
+              g(lvl.rows * lvl.cols, UNREACHABLE), parent(lvl.rows * lvl.cols, -1),
+              queues(new MessageQueue[thread_count * thread_count]) {}
+
+        unsigned owner(int cell) const {
+            std::uint32_t bx = (cell / cols) >> BLOCK_BITS;
+            std::uint32_t by = (cell % cols) >> BLOCK_BITS;
+            return ((bx * 73856093u) ^ (by * 19349663u)) % threads;
+        }
+
+        int heuristic(int cell) const {
+            return std::abs(cell / cols - goal.x) + std::abs(cell % cols - goal.y);
+        }
+
+        void offer_best(int cost){
+            int current = best.load();
+            while(cost < current && !best.compare_exchange_weak(current, cost)){}
+        }
+    };
+
+    /**
+     * @brief Search loop of one thread.
+     *
+     * A thread becomes idle when its queues are empty and it has no node
+     * with f below the best cost. Messages it processed are only taken off
+     * `in_flight` when it becomes idle, so `idle == threads` together with
+     * `in_flight == 0` means no thread has work and none can get any.
+     */
+
+    void search_worker(Search& search, unsigned id, Point start){
+        const unsigned threads = search.threads;
+        const int goal_idx = search.goal.x * search.cols + search.goal.y;
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<>> open;
+        std::vector<std::vector<Message>> overflow(threads); //filas cheias
+        long processed = 0;
+        size_t expanded = 0;
+        bool is_idle = false;
+
+        auto relax = [&](const Message& message){
+            if(message.g < search.g[message.cell]){
+                search.g[message.cell] = message.g;
+                search.parent[message.cell] = message.parent;
+                open.push({message.g + search.heuristic(message.cell), message.g, message.cell});
+            }
+        };
+
+        const int start_idx = start.x * search.cols + start.y;
+        if(search.owner(start_idx) == id){
+            relax({start_idx, 0, -1});
+        }
+
+        while(!search.done.load()){
+            Message message;
+            for(unsigned from=0;from<threads;++from){
+                while(search.queues[from * threads + id].pop(message)){
+                    if(is_idle){
+                        is_idle = false;
+                        --search.idle;
+                    }
+                    relax(message);
+                    ++processed;
+                }
+            }
+
+            for(int round=0;round<EXPANSIONS_PER_ROUND && !open.empty();++round){
+                Entry entry = open.top();
+                if(entry.f >= search.best.load(std::memory_order_relaxed)){
+                    break;
+                }
+                open.pop();
+                if(entry.g != search.g[entry.cell]){
+                    continue; //entrada antiga, o nó já foi melhorado
+                }
+                ++expanded;
+                if(entry.cell == goal_idx){
+                    search.offer_best(entry.g);
+                    continue;
+                }
+
+                const int x = entry.cell / search.cols;
+                const int y = entry.cell % search.cols;
+                for(const Point& move : MOVES){
+                    const int nx = x + move.x;
+                    const int ny = y + move.y;
+                    if(!is_open_cell(search.level, nx, ny)) continue;
+                    const int next = nx * search.cols + ny;
+                    Message out{next, entry.g + search.level.terrain_cost(search.level.board[nx][ny]), entry.cell};
+                    const unsigned to = search.owner(next);
+                    if(to == id){
+                        relax(out);
+                        continue;
+                    }
+                    ++search.in_flight;
+                    ++search.messages;
+                    if(!overflow[to].empty() || !search.queues[id * threads + to].push(out)){
+                        overflow[to].push_back(out);
+                    }
+                }
+            }
+
+            bool pending = false;
+            for(unsigned to=0;to<threads;++to){
+                auto& waiting = overflow[to];
+                size_t sent = 0;
+                while(sent < waiting.size() && search.queues[id * threads + to].push(waiting[sent])){
+                    ++sent;
+                }
+                waiting.erase(waiting.begin(), waiting.begin() + sent);
+                pending = pending || !waiting.empty();
+            }
+
+            const bool has_work = !open.empty() && open.top().f < search.best.load();
+            if(has_work || pending){
+                continue;
+            }
+            if(!is_idle){
+                is_idle = true;
+                ++search.idle;
+                search.in_flight -= processed;
+                processed = 0;
+            }
+            if(search.idle.load() == threads && search.in_flight.load() == 0){
+                search.done = true;
+            }else{
+                std::this_thread::yield();
+            }
+        }
+        search.expanded += expanded;
+    }
+}
+
+ParallelAStarStats parallel_astar(const Level& level, Point start, Point goal, unsigned threads, std::vector<Point>& path){
+    path.clear();
+    if(threads == 0){
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    Search search(level, goal, threads);
+    std::vector<std::thread> pool;
+    for(unsigned t=1;t<threads;++t){
+        pool.emplace_back(search_worker, std::ref(search), t, start);
+    }
+    search_worker(search, 0, start);
+    for(auto& thread : pool){
+        thread.join();
+    }
+
+    ParallelAStarStats stats;
+    stats.nodes_expanded = search.expanded;
+    stats.messages = search.messages;
+    if(search.best == UNREACHABLE){
+        return stats;
+    }
+
+    stats.cost = search.best;
+    const int start_idx = start.x * level.cols + start.y;
+    for(int cell = goal.x * level.cols + goal.y; cell != start_idx; cell = search.parent[cell]){
+        path.push_back({cell / level.cols, cell % level.cols});
+    }
+    std::reverse(path.begin(), path.end());
+    return stats;
+}
@@ -0,0 +1,41 @@
+#ifndef PARALLEL_ASTAR_HPP
+#define PARALLEL_ASTAR_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include "direction.hpp"
+
+class Level;
+
+/**
+ * @brief Counters of one parallel A* search.
+ */
+
+struct ParallelAStarStats {
+    size_t nodes_expanded = 0;
+    size_t messages = 0; //nós enviados para outra thread
+    int cost = -1; //custo do caminho, -1 se não há caminho
+};
+
+/**
+ * @brief Hash-distributed parallel A* (HDA*) between two cells.
+ *
+ * Every cell is owned by one thread, chosen by hashing the 8x8 block it
+ * belongs to. A thread only expands the cells it owns; successors owned by
+ * another thread are sent to it through a lock-free single-producer queue
+ * per pair of threads. The search ends when no thread has a node with f
+ * below the best cost found and no message is in flight, so the path has
+ * the same (optimal) terrain cost as the sequential A*.
+ *
+ * @param level Level to search.
+ * @param start Start of the search (not included in `path`).
+ * @param goal Target cell.
+ * @param threads Number of threads; 0 uses every hardware thread.
+ * @param path Receives the cells from start to goal, empty if unreachable.
+ * @return Counters of the search.
+ */
+
+ParallelAStarStats parallel_astar(const Level& level, Point start, Point goal, unsigned threads, std::vector<Point>& path);
+
+#endif
@@ -0,0 +1,55 @@
+#include "benchmark.hpp"
+#include "maze.hpp"
+#include "parallel_astar.hpp"
+#include "player.hpp"
+
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+/**
+ * @brief Compares parallel A* with the sequential A* on large mazes.
+ *
+ * Both use the Manhattan heuristic. For every thread count the paths
+ * must have the same cost as the sequential one; speedup is relative to
+ * the sequential planner.
+ */
+
+void bench_parallel_astar(){
+    std::cout << "\n[PARALLEL A* (HDA*) ON LARGE MAZES]\n";
+    std::cout << std::left << std::setw(18) << "board" << std::right << std::setw(9) << "threads"
+              << std::setw(12) << "ms" << std::setw(10) << "speedup" << std::setw(12) << "nodes"
+              << std::setw(12) << "messages" << std::setw(8) << "cost" << "\n";
+
+    for(int side : {1001, 2001}){
+        Level maze = generate_maze(side, side, side, 10, 30);
+        std::vector<Point> cells = open_cells(maze);
+        Point start = cells.front();
+        Point goal = cells.back();
+        std::string name = "maze " + std::to_string(side) + "x" + std::to_string(side);
+
+        Player player(maze);
+        player.use_landmarks = false;
+        auto begin = Clock::now();
+        player.computed_path_A(start, goal);
+        double sequential_ms = elapsed_ms(begin);
+        int cost = path_cost(maze, player.path);
+        std::cout << std::left << std::setw(18) << name << std::right << std::setw(9) << "seq"
+                  << std::setw(12) << std::fixed << std::setprecision(1) << sequential_ms << std::setw(10) << "1.00"
+                  << std::setw(12) << player.nodes_expanded << std::setw(12) << "-" << std::setw(8) << cost << "\n";
+
+        std::vector<Point> path;
+        for(unsigned threads : {1u, 2u, 4u, 8u, 16u}){
+            begin = Clock::now();
+            ParallelAStarStats stats = parallel_astar(maze, start, goal, threads, path);
+            double ms = elapsed_ms(begin);
+            std::cout << std::left << std::setw(18) << name << std::right << std::setw(9) << threads
+                      << std::setw(12) << ms << std::setw(10) << std::setprecision(2) << sequential_ms / ms
+                      << std::setw(12) << stats.nodes_expanded << std::setw(12) << stats.messages
+                      << std::setw(8) << stats.cost << std::setprecision(1) << "\n";
+            if(stats.cost != cost || path_cost(maze, path) != cost){
+                std::cout << "  ! path cost differs from the sequential A*\n";
+            }
+        }
+    }
+}
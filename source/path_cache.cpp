@@ -0,0 +1,104 @@
+#include "path_cache.hpp"
+
+#include <functional>
+
+size_t PathCache::KeyHash::operator()(const PathKey& key) const {
+    size_t h = std::hash<std::string_view>{}(key.planner);
+    for(int value : {(int)key.level, key.start.x, key.start.y, key.goal.x, key.goal.y}){
+        h = (h ^ (size_t)(unsigned)value) * 1099511628211ull;
+    }
+    return h;
+}
+
+/**
+ * @param capacity Paths kept at most; 0 keeps none.
+ */
+
+PathCache::PathCache(size_t max_paths) : capacity(max_paths){
+    index.reserve(capacity);
+}
+
+/**
+ * @brief Copies the cached path of `key` into `out` (reusing its buffer)
+ * and marks it as the most recently used.
+ *
+ * @return False on a miss; `out` is then unchanged.
+ */
+
+bool PathCache::find(const PathKey& key, CompactPath& out){
+    auto found = index.find(key);
+    if(found == index.end()){
+        ++miss_count;
+        return false;
+    }
+    ++hit_count;
+    entries.splice(entries.begin(), entries, found->second);
+    out = found->second->path;
+    return true;
+}
+
+/**
+ * @brief Keeps a copy of `path` under `key`, dropping the least recently
+ * used path when full.
+ */
+
+void PathCache::store(const PathKey& key, const CompactPath& path){
+    if(capacity == 0){
+        return;
+    }
+    auto found = index.find(key);
+    if(found != index.end()){
+        path_bytes -= found->second->path.memory_bytes();
+        found->second->path = path;
+        path_bytes += found->second->path.memory_bytes();
+        entries.splice(entries.begin(), entries, found->second);
+        return;
+    }
+    if(entries.size() >= capacity){
+        Entry& oldest = entries.back();
+        path_bytes -= oldest.path.memory_bytes();
+        index.erase(oldest.key);
+        entries.pop_back();
+    }
+    entries.push_front({key, path});
+    path_bytes += entries.front().path.memory_bytes();
+    index.emplace(key, entries.begin());
+}
+
+/**
+ * @brief Drops every path of a level.
+ */
+
+void PathCache::invalidate(std::uint32_t level){
+    for(auto it = entries.begin(); it != entries.end(); ){
+        if(it->key.level == level){
+            path_bytes -= it->path.memory_bytes();
+            index.erase(it->key);
+            it = entries.erase(it);
+        }else{
+            ++it;
+        }
+    }
+}
+
+void PathCache::clear(){
+    entries.clear();
+    index.clear();
+    path_bytes = 0;
+}
+
+double PathCache::hit_rate() const {
+    const size_t lookups = hit_count + miss_count;
+    return lookups ? (double)hit_count / lookups : 0.0;
+}
+
+/**
+ * @brief Approximate bytes held: the paths, one list node and one hash
+ * node per entry, and the bucket array.
+ */
+
+size_t PathCache::memory_bytes() const {
+    const size_t node = 2 * sizeof(void*) + sizeof(Entry) - sizeof(CompactPath);
+    const size_t hash_node = sizeof(void*) + sizeof(PathKey) + sizeof(void*) + sizeof(size_t);
+    return sizeof(*this) + path_bytes + entries.size() * (node + hash_node) + index.bucket_count() * sizeof(void*);
+}
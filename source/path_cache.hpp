@@ -0,0 +1,79 @@
+#ifndef PATH_CACHE_HPP
+#define PATH_CACHE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <string_view>
+#include <unordered_map>
+
+#include "direction.hpp"
+#include "compact_path.hpp"
+
+/**
+ * @brief What a cached path answers: a planner's path on a level from a
+ * start cell to a goal cell.
+ */
+
+struct PathKey {
+    std::uint32_t level; //número do nível no jogo
+    Point start;
+    Point goal;
+    std::string_view planner; //Planner::name
+
+    bool operator==(const PathKey& other) const {
+        return level == other.level && start == other.start && goal == other.goal && planner == other.planner;
+    }
+};
+
+/**
+ * @brief Bounded LRU cache of planned paths.
+ *
+ * walk_route looks the path up before calling a deterministic single-pellet
+ * planner and stores what the planner gave on a miss, so a repeated query
+ * (the same food from the same cell, e.g. in games with the same seed on
+ * the same level) costs a copy of a CompactPath instead of a search. When
+ * `capacity` paths are stored the least recently used one is dropped.
+ *
+ * Paths depend only on walls and terrain, so entries stay valid while the
+ * level is played; `invalidate` drops those of a level that was replaced
+ * or changed and `clear` drops everything.
+ */
+
+class PathCache {
+    public:
+        static const size_t DEFAULT_CAPACITY = 4096;
+
+        explicit PathCache(size_t capacity = DEFAULT_CAPACITY);
+
+        bool find(const PathKey& key, CompactPath& out);
+        void store(const PathKey& key, const CompactPath& path);
+        void invalidate(std::uint32_t level);
+        void clear();
+
+        size_t size() const { return entries.size(); }
+        size_t get_capacity() const { return capacity; }
+        size_t hits() const { return hit_count; }
+        size_t misses() const { return miss_count; }
+        double hit_rate() const;
+        size_t memory_bytes() const;
+
+    private:
+        struct KeyHash {
+            size_t operator()(const PathKey& key) const;
+        };
+
+        struct Entry {
+            PathKey key;
+            CompactPath path;
+        };
+
+        size_t capacity;
+        std::list<Entry> entries; //mais recente na frente
+        std::unordered_map<PathKey, std::list<Entry>::iterator, KeyHash> index;
+        size_t path_bytes = 0; //buffers dos caminhos guardados
+        size_t hit_count = 0;
+        size_t miss_count = 0;
+};
+
+#endif
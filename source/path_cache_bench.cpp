@@ -0,0 +1,91 @@
+#include "benchmark.hpp"
+#include "path_cache.hpp"
+#include "planner.hpp"
+
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+
+namespace {
+    /**
+     * @brief Plays one food run of a level (until `food` pellets or a
+     * crash) with a planner, as the simulation does, and returns the
+     * steps taken. The time spent in walk_route is added to `think_ms`.
+     */
+
+    template <typename Planner>
+    size_t play_food_run(const Level& level, std::uint32_t level_id, unsigned seed, size_t food, PathCache* cache, double& think_ms){
+        const size_t STEP_LIMIT = 20000;
+        Level lvl = level;
+        std::mt19937 generator(seed);
+        Player player(lvl);
+        RouteWalk walk;
+        walk.cache = cache;
+        walk.level = level_id;
+        Point head = lvl.start_mouse;
+        lvl.reset_level(true);
+
+        size_t steps = 0;
+        for(size_t eaten = 0; eaten < food && steps < STEP_LIMIT; ){
+            lvl.generate_food(generator);
+            lvl.fill_data(head, false);
+            StepResult result = StepResult::MOVED;
+            while(result != StepResult::ATE && result != StepResult::CRASHED && steps < STEP_LIMIT){
+                auto begin = Clock::now();
+                result = walk_route<Planner>(player, lvl, head, walk);
+                think_ms += elapsed_ms(begin);
+                ++steps;
+                lvl.reset_level(false);
+                lvl.fill_data(head, false);
+            }
+            if(result != StepResult::ATE) break;
+            ++eaten;
+        }
+        return steps;
+    }
+
+    /**
+     * @brief Path cache on repeated runs: every level is played with a few
+     * seeds, each seed several times (as when comparing runs of a batch),
+     * with and without a cache. Times are of the THINKING steps only; the
+     * steps taken must not change.
+     */
+
+    template <typename Planner>
+    void bench_cache_with(const std::vector<Level>& levels){
+        const unsigned seeds = 8;
+        const int repeats = 4;
+        const size_t food = 10;
+
+        PathCache cache(PathCache::DEFAULT_CAPACITY);
+        size_t plain_steps = 0;
+        size_t cached_steps = 0;
+        double plain_ms = 0;
+        double cached_ms = 0;
+        for(size_t i=0;i<levels.size();++i){
+            for(int r=0;r<repeats;++r){
+                for(unsigned seed=0;seed<seeds;++seed){
+                    plain_steps += play_food_run<Planner>(levels[i], i, seed, food, nullptr, plain_ms);
+                    cached_steps += play_food_run<Planner>(levels[i], i, seed, food, &cache, cached_ms);
+                }
+            }
+        }
+
+        std::cout << std::left << std::setw(14) << Planner::name << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(11) << plain_ms << std::setw(11) << cached_ms << std::setw(10) << cache.hit_rate() * 100
+                  << std::setw(8) << cache.size() << std::setw(10) << cache.memory_bytes() / 1024.0 << "\n";
+        if(plain_steps != cached_steps){
+            std::cout << "  ! " << plain_steps << " steps without the cache, " << cached_steps << " with it\n";
+        }
+    }
+}
+
+void bench_cache(const std::vector<Level>& levels){
+    std::cout << "\n[PATH CACHE (8 seeds x 4 runs per level)]\n";
+    std::cout << std::left << std::setw(14) << "planner" << std::right << std::setw(11) << "think ms" << std::setw(11) << "cached ms"
+              << std::setw(10) << "hit %" << std::setw(8) << "paths" << std::setw(10) << "KiB" << "\n";
+    bench_cache_with<AStarPlanner>(levels);
+    bench_cache_with<BacktrackingPlanner>(levels);
+    bench_cache_with<CorridorPlanner>(levels);
+}
@@ -0,0 +1,322 @@
+#include "path_database.hpp"
+#include "level.hpp"
+#include "search.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <thread>
+
+namespace {
+    const char MAGIC[8] = {'M', 'O', 'U', 'Z', 'E', 'C', 'P', 'D'};
+    const std::uint32_t FORMAT_VERSION = 1;
+
+    const int MAX_STEP_COST = 10; //Level::terrain_cost de '@'
+    const int BUCKETS = MAX_STEP_COST + 1;
+
+    //memória de uma thread do build, reaproveitada entre as origens
+    struct BuildScratch {
+        std::vector<int> dist;
+        std::vector<std::uint8_t> first; //primeiro passo a partir da origem
+        std::vector<int> buckets[BUCKETS]; //células por distância, módulo BUCKETS
+    };
+
+    template <typename T>
+    void put(std::ostream& out, const T& value){
+        out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    bool get(std::istream& in, T& value){
+        return (bool)in.read(reinterpret_cast<char*>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    bool get_vector(std::istream& in, std::vector<T>& values, size_t count){
+        values.resize(count);
+        return (bool)in.read(reinterpret_cast<char*>(values.data()), count * sizeof(T));
+    }
+}
+
+/**
+ * @brief Copies walls and terrain and orders the open cells depth-first,
+ * one component after another.
+ */
+
+void PathDatabase::prepare(const Level& level){
+    rows = level.rows;
+    cols = level.cols;
+    const size_t cells = (size_t)rows * cols;
+
+    //FNV-1a das dimensões e do custo de cada célula
+    board_hash = 1469598103934665603ull;
+    auto mix = [this](std::uint64_t value){
+        board_hash = (board_hash ^ value) * 1099511628211ull;
+    };
+    mix(rows);
+    mix(cols);
+
+    cost.assign(cells, 0);
+    for(int i=0;i<rows;++i){
+        for(int j=0;j<cols;++j){
+            if(is_open_cell(level, i, j)){
+                cost[index({i, j})] = level.terrain_cost(level.board[i][j]);
+            }
+            mix(cost[index({i, j})]);
+        }
+    }
+
+    order.assign(cells, NO_CELL);
+    component.assign(cells, NO_CELL);
+    std::uint32_t position = 0;
+    std::uint32_t components = 0;
+    std::vector<int> stack;
+    for(size_t root=0;root<cells;++root){
+        if(cost[root] == 0 || order[root] != NO_CELL) continue;
+        stack.push_back((int)root);
+        while(!stack.empty()){
+            const int cell = stack.back();
+            stack.pop_back();
+            if(order[cell] != NO_CELL) continue;
+            order[cell] = position++;
+            component[cell] = components;
+            const Point p{cell / cols, cell % cols};
+            //empilhados ao contrário para visitar na ordem de MOVES
+            for(int d=3;d>=0;--d){
+                const Point next{p.x + MOVES[d].x, p.y + MOVES[d].y};
+                if(is_open(next) && order[index(next)] == NO_CELL){
+                    stack.push_back(index(next));
+                }
+            }
+        }
+        ++components;
+    }
+}
+
+bool PathDatabase::is_open(Point p) const {
+    return p.x >= 0 && p.y >= 0 && p.x < rows && p.y < cols && cost[index(p)] != 0;
+}
+
+/**
+ * @brief Computes the first-move tables of a level.
+ *
+ * @param threads Threads sharing the source cells; 0 uses every hardware
+ * thread.
+ */
+
+void PathDatabase::build(const Level& level, unsigned threads){
+    prepare(level);
+    const size_t cells = cost.size();
+
+    std::vector<int> by_order(cells, -1); //célula em cada posição da ordem
+    for(size_t cell=0;cell<cells;++cell){
+        if(order[cell] != NO_CELL){
+            by_order[order[cell]] = (int)cell;
+        }
+    }
+
+    std::vector<std::vector<std::uint32_t>> row_runs(cells);
+    std::atomic<size_t> next_source{0};
+
+    auto work = [&](){
+        BuildScratch scratch;
+        scratch.dist.resize(cells);
+        scratch.first.resize(cells);
+        for(size_t source = next_source++; source < cells; source = next_source++){
+            if(cost[source] == 0) continue;
+
+            //Dijkstra da origem com baldes (os custos vão de 1 a MAX_STEP_COST);
+            //cada célula herda o primeiro passo do pai
+            std::fill(scratch.dist.begin(), scratch.dist.end(), UNREACHABLE);
+            scratch.dist[source] = 0;
+            scratch.buckets[0].push_back((int)source);
+            size_t pending = 1;
+            for(int d = 0; pending > 0; ++d){
+                std::vector<int>& bucket = scratch.buckets[d % BUCKETS];
+                for(size_t k = 0; k < bucket.size(); ++k){
+                    const int cell = bucket[k];
+                    if(scratch.dist[cell] != d) continue; //entrada antiga
+                    const Point p{cell / cols, cell % cols};
+                    for(int m=0;m<4;++m){
+                        const Point next{p.x + MOVES[m].x, p.y + MOVES[m].y};
+                        if(!is_open(next)) continue;
+                        const int n = index(next);
+                        if(d + cost[n] >= scratch.dist[n]) continue;
+                        scratch.dist[n] = d + cost[n];
+                        scratch.first[n] = (size_t)cell == source ? m : scratch.first[cell];
+                        scratch.buckets[scratch.dist[n] % BUCKETS].push_back(n);
+                        ++pending;
+                    }
+                }
+                pending -= bucket.size();
+                bucket.clear();
+            }
+
+            //um trecho a cada troca de passo; alvos sem passo seguem o trecho atual
+            std::vector<std::uint32_t>& row = row_runs[source];
+            int current = -1;
+            for(size_t pos=0;pos<cells && by_order[pos] >= 0;++pos){
+                const int target = by_order[pos];
+                if((size_t)target == source || scratch.dist[target] == UNREACHABLE) continue;
+                if(scratch.first[target] != current){
+                    current = scratch.first[target];
+                    //o primeiro trecho começa na posição 0 para toda busca cair em algum
+                    row.push_back((row.empty() ? 0u : (std::uint32_t)pos << 2) | (std::uint32_t)current);
+                }
+            }
+            row.shrink_to_fit();
+        }
+    };
+
+    if(threads == 0){
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    std::vector<std::thread> pool;
+    for(unsigned t=1;t<threads;++t){
+        pool.emplace_back(work);
+    }
+    work();
+    for(std::thread& thread : pool){
+        thread.join();
+    }
+
+    row_start.assign(cells + 1, 0);
+    for(size_t cell=0;cell<cells;++cell){
+        row_start[cell + 1] = row_start[cell] + (std::uint32_t)row_runs[cell].size();
+    }
+    runs.clear();
+    runs.reserve(row_start[cells]);
+    for(std::vector<std::uint32_t>& row : row_runs){
+        runs.insert(runs.end(), row.begin(), row.end());
+    }
+}
+
+/**
+ * @brief First move of an optimal path from `start` to `goal`.
+ *
+ * @return False if there is no path or start is the goal.
+ */
+
+bool PathDatabase::first_move(Point start, Point goal, Dir& move) const {
+    if(!is_open(start) || !is_open(goal) || start == goal) return false;
+    const int s = index(start);
+    const int t = index(goal);
+    if(component[s] != component[t]) return false;
+
+    //último trecho que começa até a posição do alvo
+    const std::uint32_t* begin = runs.data() + row_start[s];
+    const std::uint32_t* end = runs.data() + row_start[s + 1];
+    const std::uint32_t* run = std::upper_bound(begin, end, (order[t] << 2) | 3u) - 1;
+    move = static_cast<Dir>(*run & 3);
+    return true;
+}
+
+/**
+ * @brief Path from query.start to query.goal by following first moves.
+ *
+ * @return False if the goal cannot be reached; result.cost is then -1.
+ */
+
+bool PathDatabase::plan(const PathQuery& query, PathResult& result) const {
+    result.cost = -1;
+    result.moves.clear();
+    if(!is_open(query.start) || !is_open(query.goal)) return false;
+    if(component[index(query.start)] != component[index(query.goal)]) return false;
+
+    int total = 0;
+    Point at = query.start;
+    Dir move;
+    while(first_move(at, query.goal, move)){
+        at = {at.x + MOVES[move].x, at.y + MOVES[move].y};
+        total += cost[index(at)];
+        result.moves.push_back(move);
+    }
+    result.cost = total;
+    return true;
+}
+
+size_t PathDatabase::memory_bytes() const {
+    return sizeof(*this) + cost.capacity() * sizeof(int)
+        + (order.capacity() + component.capacity() + row_start.capacity() + runs.capacity()) * sizeof(std::uint32_t);
+}
+
+void PathDatabase::write(std::ostream& out) const {
+    put(out, (std::int32_t)rows);
+    put(out, (std::int32_t)cols);
+    put(out, board_hash);
+    put(out, (std::uint32_t)runs.size());
+    out.write(reinterpret_cast<const char*>(row_start.data()), row_start.size() * sizeof(std::uint32_t));
+    out.write(reinterpret_cast<const char*>(runs.data()), runs.size() * sizeof(std::uint32_t));
+}
+
+/**
+ * @brief Reads tables written by `write` for `level`.
+ *
+ * @return False if the stream is short or the tables are of another board.
+ */
+
+bool PathDatabase::read(std::istream& in, const Level& level){
+    prepare(level);
+    std::int32_t file_rows, file_cols;
+    std::uint64_t file_hash;
+    std::uint32_t run_total;
+    if(!get(in, file_rows) || !get(in, file_cols) || !get(in, file_hash) || !get(in, run_total)
+        || file_rows != rows || file_cols != cols || file_hash != board_hash
+        || !get_vector(in, row_start, cost.size() + 1) || row_start.back() != run_total
+        || !get_vector(in, runs, run_total)){
+        rows = 0;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Database file kept next to a level file: `levels.dat` gives
+ * `levels.cpd`.
+ */
+
+std::string path_database_filename(const std::string& level_filename){
+    const size_t dot = level_filename.rfind(".dat");
+    return (dot == std::string::npos ? level_filename : level_filename.substr(0, dot)) + ".cpd";
+}
+
+/**
+ * @brief Writes the databases of every level of a file, in level order.
+ */
+
+bool write_path_databases(const std::string& filename, const std::vector<PathDatabase>& databases){
+    std::ofstream out(filename, std::ios::binary);
+    out.write(MAGIC, sizeof(MAGIC));
+    put(out, FORMAT_VERSION);
+    put(out, (std::uint32_t)databases.size());
+    for(const PathDatabase& database : databases){
+        database.write(out);
+    }
+    return (bool)out;
+}
+
+/**
+ * @brief Reads the databases of `levels` from a file written by
+ * write_path_databases.
+ *
+ * @return False if the file is missing, of another version, or was built
+ * for other levels (e.g. the .dat was edited after the build).
+ */
+
+bool read_path_databases(const std::string& filename, const std::vector<Level>& levels, std::vector<PathDatabase>& databases){
+    std::ifstream in(filename, std::ios::binary);
+    char magic[sizeof(MAGIC)];
+    std::uint32_t version, count;
+    if(!in.read(magic, sizeof(magic)) || !std::equal(magic, magic + sizeof(magic), MAGIC)
+        || !get(in, version) || version != FORMAT_VERSION || !get(in, count) || count != levels.size()){
+        return false;
+    }
+    databases.assign(levels.size(), PathDatabase());
+    for(size_t i=0;i<levels.size();++i){
+        if(!databases[i].read(in, levels[i])){
+            databases.clear();
+            return false;
+        }
+    }
+    return true;
+}
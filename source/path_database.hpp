@@ -0,0 +1,72 @@
+#ifndef PATH_DATABASE_HPP
+#define PATH_DATABASE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "direction.hpp"
+#include "path_query.hpp"
+
+class Level;
+
+/**
+ * @brief Compressed path database (CPD) of one level: the first move of an
+ * optimal path from every open cell to every other one.
+ *
+ * `build` runs one Dijkstra per source cell (spread over threads), each
+ * cell inheriting the first move of its parent. The row of a source lists
+ * the first move towards each target in depth-first order of the cells, so
+ * targets in the same corridor or room sit together and share a move; each
+ * row is stored as runs `(first target << 2) | Dir`. Targets that need no
+ * move (the source itself, other components) take whichever move is
+ * running, which only lengthens runs.
+ *
+ * A query looks the first move up with a binary search in the row of the
+ * current cell and repeats from the next cell, so a path costs one lookup
+ * per step and no search. Answers have the same cost as A*; among equal
+ * paths the choice may differ.
+ *
+ * The tables depend only on walls and terrain, checked with a hash of the
+ * board when read back (see write_path_databases).
+ */
+
+class PathDatabase {
+    public:
+        void build(const Level& level, unsigned threads = 0);
+
+        bool first_move(Point start, Point goal, Dir& move) const;
+        bool plan(const PathQuery& query, PathResult& result) const;
+
+        bool empty() const { return rows == 0; }
+        size_t run_count() const { return runs.size(); }
+        size_t memory_bytes() const;
+
+        void write(std::ostream& out) const;
+        bool read(std::istream& in, const Level& level);
+
+    private:
+        static constexpr std::uint32_t NO_CELL = UINT32_MAX;
+
+        int rows = 0;
+        int cols = 0;
+        std::uint64_t board_hash = 0;
+        std::vector<int> cost; //custo de entrar na célula; 0 é parede
+        std::vector<std::uint32_t> order; //posição da célula na ordem em profundidade
+        std::vector<std::uint32_t> component; //células da mesma componente têm caminho
+        std::vector<std::uint32_t> row_start; //por célula, início dos seus trechos em `runs`
+        std::vector<std::uint32_t> runs;
+
+        void prepare(const Level& level);
+        int index(Point p) const { return p.x * cols + p.y; }
+        bool is_open(Point p) const;
+};
+
+std::string path_database_filename(const std::string& level_filename);
+bool write_path_databases(const std::string& filename, const std::vector<PathDatabase>& databases);
+bool read_path_databases(const std::string& filename, const std::vector<Level>& levels, std::vector<PathDatabase>& databases);
+
+#endif
@@ -0,0 +1,80 @@
+#include "benchmark.hpp"
+#include "path_database.hpp"
+#include "path_query.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+/**
+ * @brief Path database (first-move tables) against PathPlanner A*.
+ *
+ * Builds the tables on one thread and on all of them, reports their
+ * size against a plain 2-bit table of every pair of open cells, checks
+ * a write/read round trip and answers the same random pairs with both;
+ * costs must match.
+ */
+
+void bench_cpd(const std::vector<Level>& levels){
+    const int queries = 2000;
+    const unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    std::cout << "\n[PATH DATABASE: FIRST-MOVE TABLES x A* (" << queries << " queries, " << threads << " threads)]\n";
+    std::cout << std::left << std::setw(18) << "board" << std::right << std::setw(10) << "build ms" << std::setw(12) << "parallel ms"
+              << std::setw(10) << "runs" << std::setw(10) << "KiB" << std::setw(10) << "raw KiB"
+              << std::setw(12) << "A* q/s" << std::setw(12) << "cpd q/s" << std::setw(10) << "speedup" << "\n";
+
+    for(const auto& [name, level] : terrain_boards(levels)){
+        QuerySampler sampler(level, 11);
+        if(!sampler.usable()) continue;
+
+        PathDatabase database;
+        auto begin = Clock::now();
+        database.build(level, 1);
+        double build_ms = elapsed_ms(begin);
+        begin = Clock::now();
+        database.build(level, threads);
+        double parallel_ms = elapsed_ms(begin);
+
+        std::stringstream file;
+        database.write(file);
+        PathDatabase loaded;
+        bool round_trip = loaded.read(file, level) && loaded.run_count() == database.run_count();
+
+        const std::vector<PathQuery> batch = sampler.queries(queries);
+
+        PathPlanner planner(level);
+        PathScratch scratch;
+        PathResult result;
+        std::vector<int> astar_cost(queries);
+        begin = Clock::now();
+        for(int k=0;k<queries;++k){
+            planner.plan(batch[k], result, scratch);
+            astar_cost[k] = result.cost;
+        }
+        double astar_ms = elapsed_ms(begin);
+
+        size_t mismatches = 0;
+        begin = Clock::now();
+        for(int k=0;k<queries;++k){
+            loaded.plan(batch[k], result);
+            mismatches += result.cost != astar_cost[k];
+        }
+        double cpd_ms = elapsed_ms(begin);
+
+        const size_t cells = sampler.cells().size();
+        double raw_kib = (double)cells * cells / 4 / 1024;
+        std::cout << std::left << std::setw(18) << name << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(10) << build_ms << std::setw(12) << parallel_ms << std::setw(10) << database.run_count()
+                  << std::setw(10) << database.memory_bytes() / 1024.0 << std::setw(10) << raw_kib
+                  << std::setprecision(0) << std::setw(12) << queries / (astar_ms / 1000) << std::setw(12) << queries / (cpd_ms / 1000)
+                  << std::setw(9) << std::setprecision(1) << astar_ms / cpd_ms << "x\n";
+        if(!round_trip){
+            std::cout << "  ! tables read back differ\n";
+        }
+        if(mismatches){
+            std::cout << "  ! " << mismatches << " paths with different costs\n";
+        }
+    }
+}
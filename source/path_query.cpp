@@ -0,0 +1,423 @@
+#include "path_query.hpp"
+#include "landmarks.hpp"
+#include "level.hpp"
+#include "search.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <thread>
+
+namespace {
+    const size_t QUERIES_PER_GRAB = 16; //consultas que uma thread pega de cada vez
+    const int OPPOSITE[4] = {Dir::S, Dir::N, Dir::O, Dir::L};
+
+    //menor f primeiro; no empate, o mais fundo (maior g)
+    struct EntryAfter {
+        template <typename Entry>
+        bool operator()(const Entry& a, const Entry& b) const {
+            return a.f != b.f ? a.f > b.f : a.g < b.g;
+        }
+    };
+}
+
+//espalha os 16 bits baixos de v nas posições pares
+std::uint32_t PathPlanner::MortonCells::spread(std::uint32_t v){
+    v &= 0xFFFF;
+    v = (v | (v << 8)) & 0x00FF00FF;
+    v = (v | (v << 4)) & 0x0F0F0F0F;
+    v = (v | (v << 2)) & 0x33333333;
+    v = (v | (v << 1)) & 0x55555555;
+    return v;
+}
+
+//inverso de spread: junta os bits das posições pares
+std::uint32_t PathPlanner::MortonCells::compact(std::uint32_t v){
+    v &= 0x55555555;
+    v = (v | (v >> 1)) & 0x33333333;
+    v = (v | (v >> 2)) & 0x0F0F0F0F;
+    v = (v | (v >> 4)) & 0x00FF00FF;
+    v = (v | (v >> 8)) & 0x0000FFFF;
+    return v;
+}
+
+/**
+ * @brief Neighbour in direction d, by adding or subtracting one unit of the
+ * interleaved row or column: filling the bits of the other coordinate with
+ * ones lets the carry skip over them.
+ */
+
+int PathPlanner::MortonCells::step(int cell, int d) const {
+    const std::uint32_t c = cell;
+    switch(d){
+        case Dir::N: return (((c & mask_x) - 2) & mask_x) | (c & mask_y);
+        case Dir::S: return (((c | mask_y) + 2) & mask_x) | (c & mask_y);
+        case Dir::L: return (((c | mask_x) + 1) & mask_y) | (c & mask_x);
+        default:     return (((c & mask_y) - 1) & mask_y) | (c & mask_x);
+    }
+}
+
+/**
+ * @brief Prepares a level: padded cost board and landmark tables.
+ *
+ * @param level Level to plan on; walls and terrain are copied.
+ * @param landmark_count Landmarks for the ALT bound; 0 uses Manhattan only.
+ * @param layout Order of the cells in the per-cell arrays. MORTON pads the
+ * board to a power-of-two square, up to 32766 cells a side.
+ */
+
+PathPlanner::PathPlanner(const Level& level, int landmark_count, CellLayout cell_layout)
+    : rows(level.rows), cols(level.cols), layout(cell_layout){
+    const int stride = cols + 2;
+    row_major.stride = stride;
+    row_major.offsets[Dir::N] = -stride;
+    row_major.offsets[Dir::S] = stride;
+    row_major.offsets[Dir::L] = 1;
+    row_major.offsets[Dir::O] = -1;
+
+    int side_bits = 0;
+    while((1 << side_bits) < std::max(rows, cols) + 2) ++side_bits;
+    morton.mask_y = (std::uint32_t)(((std::uint64_t)1 << (2 * side_bits)) - 1) & 0x55555555u;
+    morton.mask_x = morton.mask_y << 1;
+
+    cost.assign(layout == CellLayout::MORTON ? (size_t)1 << (2 * side_bits) : (size_t)(rows + 2) * stride, 0);
+    for(int i=0;i<rows;++i){
+        for(int j=0;j<cols;++j){
+            if(is_open_cell(level, i, j)){
+                cost[index({i, j})] = level.terrain_cost(level.board[i][j]);
+            }
+        }
+    }
+
+    Landmarks chosen;
+    chosen.build(level, landmark_count);
+    landmarks = chosen.count();
+    bounds.assign(cost.size() * 2 * landmarks, UNREACHABLE);
+    for(int l=0;l<landmarks;++l){
+        const std::vector<int>& from = chosen.distances_from(l);
+        const std::vector<int>& to = chosen.distances_to(l);
+        for(int i=0;i<rows;++i){
+            for(int j=0;j<cols;++j){
+                int* cell = &bounds[index({i, j}) * 2 * landmarks];
+                cell[l] = from[i * cols + j];
+                cell[landmarks + l] = to[i * cols + j];
+            }
+        }
+    }
+}
+
+int PathPlanner::index(Point p) const {
+    return layout == CellLayout::MORTON ? morton.index(p.x, p.y) : row_major.index(p.x, p.y);
+}
+
+bool PathPlanner::is_open(Point p) const {
+    return p.x >= 0 && p.y >= 0 && p.x < rows && p.y < cols && cost[index(p)] != 0;
+}
+
+/**
+ * @brief Largest of the Manhattan distance and the ALT bound (see
+ * Landmarks::lower_bound) from a cell to the goal.
+ */
+
+int PathPlanner::heuristic(int cell, Point p, Point goal, const std::vector<int>& goal_bounds) const {
+    int bound = std::abs(p.x - goal.x) + std::abs(p.y - goal.y);
+    const int* here = &bounds[cell * 2 * landmarks];
+    for(int k=0;k<2 * landmarks;++k){
+        if(here[k] == UNREACHABLE || goal_bounds[k] == UNREACHABLE) continue;
+        //de L: d(L,objetivo) - d(L,célula); até L: d(célula,L) - d(objetivo,L)
+        bound = std::max(bound, k < landmarks ? goal_bounds[k] - here[k] : here[k] - goal_bounds[k]);
+    }
+    return bound;
+}
+
+/**
+ * @brief Makes room for levels of up to `cells` cells (see
+ * PathPlanner::cell_count); never shrinks.
+ */
+
+void PathScratch::reserve(size_t cells){
+    if(stamp.size() >= cells){
+        return;
+    }
+    g.assign(cells, 0);
+    h.assign(cells, 0);
+    via.assign(cells, 0);
+    stamp.assign(cells, 0);
+    current = 0;
+}
+
+/**
+ * @brief Gives the scratch a new search number, growing it if this level
+ * is larger than any it served before.
+ */
+
+unsigned PathPlanner::begin_search(PathScratch& scratch) const {
+    scratch.reserve(cost.size());
+    if(++scratch.current == 0){ //a contagem deu a volta
+        std::fill(scratch.stamp.begin(), scratch.stamp.end(), 0);
+        scratch.current = 1;
+    }
+    return scratch.current;
+}
+
+/**
+ * @brief A* from query.start to query.goal.
+ *
+ * Same costs as Player::computed_path_A: moving into a cell costs its
+ * terrain. Safe to call concurrently as long as each thread passes its own
+ * scratch.
+ *
+ * @return False if start or goal is not an open cell or the goal cannot
+ * be reached (result.cost is then -1).
+ */
+
+bool PathPlanner::plan(const PathQuery& query, PathResult& result, PathScratch& scratch) const {
+    result.cost = -1;
+    result.moves.clear();
+    if(!is_open(query.start) || !is_open(query.goal)){
+        return false;
+    }
+    return layout == CellLayout::MORTON ? search(morton, query, result, scratch) : search(row_major, query, result, scratch);
+}
+
+template <typename Cells>
+bool PathPlanner::search(const Cells& cells, const PathQuery& query, PathResult& result, PathScratch& scratch) const {
+
+    const unsigned current = begin_search(scratch);
+    auto& open = scratch.open;
+    open.clear();
+
+    const int start = index(query.start);
+    const int goal = index(query.goal);
+    const auto goal_row = bounds.begin() + goal * 2 * landmarks;
+    scratch.goal_bounds.assign(goal_row, goal_row + 2 * landmarks);
+    scratch.stamp[start] = current;
+    scratch.g[start] = 0;
+    open.push_back({heuristic(start, query.start, query.goal, scratch.goal_bounds), 0, start});
+
+    bool found = false;
+    while(!open.empty()){
+        std::pop_heap(open.begin(), open.end(), EntryAfter{});
+        const PathScratch::Entry entry = open.back();
+        open.pop_back();
+        if(entry.g != scratch.g[entry.cell]){
+            continue; //entrada antiga, o nó já foi melhorado
+        }
+        ++scratch.nodes_expanded;
+        if(entry.cell == goal){
+            found = true;
+            break;
+        }
+
+        const Point here = cells.point(entry.cell);
+        for(int d=0;d<4;++d){
+            const int next = cells.step(entry.cell, d);
+            if(cost[next] == 0) continue;
+            const int g = entry.g + cost[next];
+            if(scratch.stamp[next] != current){
+                scratch.stamp[next] = current;
+                scratch.h[next] = heuristic(next, {here.x + MOVES[d].x, here.y + MOVES[d].y}, query.goal, scratch.goal_bounds);
+            }else if(g >= scratch.g[next]){
+                continue;
+            }
+            scratch.g[next] = g;
+            scratch.via[next] = d;
+            open.push_back({g + scratch.h[next], g, next});
+            std::push_heap(open.begin(), open.end(), EntryAfter{});
+        }
+    }
+    if(!found){
+        return false;
+    }
+
+    result.cost = scratch.g[goal];
+    for(int cell = goal; cell != start; cell = cells.step(cell, OPPOSITE[scratch.via[cell]])){
+        result.moves.push_back(static_cast<Dir>(scratch.via[cell]));
+    }
+    std::reverse(result.moves.begin(), result.moves.end());
+    return true;
+}
+
+/**
+ * @brief Dijkstra from the goal with reversed costs: afterwards g[c] is the
+ * cost from c to the goal and via[c] the first step of that path.
+ *
+ * Stamped like plan(), so the cells not reached keep an old stamp.
+ */
+
+void PathPlanner::distance_field(Point goal, PathScratch& scratch) const {
+    if(layout == CellLayout::MORTON){
+        sweep(morton, goal, scratch);
+    }else{
+        sweep(row_major, goal, scratch);
+    }
+}
+
+template <typename Cells>
+void PathPlanner::sweep(const Cells& cells, Point goal, PathScratch& scratch) const {
+    const unsigned current = begin_search(scratch);
+    auto& open = scratch.open;
+    open.clear();
+
+    const int source = index(goal);
+    scratch.stamp[source] = current;
+    scratch.g[source] = 0;
+    open.push_back({0, 0, source});
+
+    while(!open.empty()){
+        std::pop_heap(open.begin(), open.end(), EntryAfter{});
+        const PathScratch::Entry entry = open.back();
+        open.pop_back();
+        if(entry.g != scratch.g[entry.cell]){
+            continue;
+        }
+        ++scratch.nodes_expanded;
+
+        //do vizinho para cá custa o terreno daqui
+        const int g = entry.g + cost[entry.cell];
+        for(int d=0;d<4;++d){
+            const int next = cells.step(entry.cell, d);
+            if(cost[next] == 0) continue;
+            if(scratch.stamp[next] == current && g >= scratch.g[next]) continue;
+            scratch.stamp[next] = current;
+            scratch.g[next] = g;
+            scratch.via[next] = OPPOSITE[d];
+            open.push_back({g, g, next});
+            std::push_heap(open.begin(), open.end(), EntryAfter{});
+        }
+    }
+}
+
+void PathPlanner::follow_field(const PathQuery& query, PathResult& result, const PathScratch& scratch) const {
+    if(layout == CellLayout::MORTON){
+        follow(morton, query, result, scratch);
+    }else{
+        follow(row_major, query, result, scratch);
+    }
+}
+
+template <typename Cells>
+void PathPlanner::follow(const Cells& cells, const PathQuery& query, PathResult& result, const PathScratch& scratch) const {
+    result.cost = -1;
+    result.moves.clear();
+    if(!is_open(query.start)){
+        return;
+    }
+    const int start = index(query.start);
+    if(scratch.stamp[start] != scratch.current){
+        return;
+    }
+    result.cost = scratch.g[start];
+    const int goal = index(query.goal);
+    for(int cell = start; cell != goal; cell = cells.step(cell, scratch.via[cell])){
+        result.moves.push_back(static_cast<Dir>(scratch.via[cell]));
+    }
+}
+
+/**
+ * @brief Answers a batch of queries.
+ *
+ * Queries are grouped by goal; groups of at least GROUP_MIN queries share
+ * one distance field, the others run one A* each. With more than one
+ * thread, groups are handed out from a shared counter, so long and short
+ * searches balance out. Not reentrant: the scratch kept in the planner is
+ * reused.
+ *
+ * @param threads Threads to use; 0 uses every hardware thread.
+ * @return One result per query, in the same order.
+ */
+
+std::vector<PathResult> PathPlanner::plan_many(const std::vector<PathQuery>& queries, unsigned threads){
+    std::vector<PathResult> results(queries.size());
+
+    //consultas ordenadas pelo objetivo; cada tarefa é um intervalo de `order`
+    std::vector<size_t> order(queries.size());
+    for(size_t i=0;i<order.size();++i){
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b){
+        return queries[a].goal < queries[b].goal;
+    });
+    struct Task {
+        size_t begin;
+        size_t end;
+        bool shared; //um campo de distâncias para o grupo todo
+    };
+    std::vector<Task> tasks;
+    for(size_t begin = 0; begin < order.size();){
+        size_t end = begin + 1;
+        while(end < order.size() && queries[order[end]].goal == queries[order[begin]].goal) ++end;
+        if(end - begin >= GROUP_MIN && is_open(queries[order[begin]].goal)){
+            tasks.push_back({begin, end, true});
+        }else{
+            for(size_t b = begin; b < end; b += QUERIES_PER_GRAB){
+                tasks.push_back({b, std::min(end, b + QUERIES_PER_GRAB), false});
+            }
+        }
+        begin = end;
+    }
+
+    if(threads == 0){
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threads = std::max<size_t>(1, std::min<size_t>(threads, tasks.size()));
+    if(scratch.size() < threads){
+        scratch.resize(threads);
+    }
+
+    std::atomic<size_t> next{0};
+    auto work = [&](unsigned id){
+        for(size_t t = next++; t < tasks.size(); t = next++){
+            const Task& task = tasks[t];
+            if(task.shared){
+                distance_field(queries[order[task.begin]].goal, scratch[id]);
+            }
+            for(size_t i=task.begin;i<task.end;++i){
+                if(task.shared){
+                    follow_field(queries[order[i]], results[order[i]], scratch[id]);
+                }else{
+                    plan(queries[order[i]], results[order[i]], scratch[id]);
+                }
+            }
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for(unsigned id=1;id<threads;++id){
+        pool.emplace_back(work, id);
+    }
+    work(0);
+    for(auto& thread : pool){
+        thread.join();
+    }
+    return results;
+}
+
+/**
+ * @brief Nodes expanded by every plan_many call so far.
+ */
+
+size_t PathPlanner::nodes_expanded() const {
+    size_t total = 0;
+    for(const PathScratch& s : scratch){
+        total += s.nodes_expanded;
+    }
+    return total;
+}
+
+CellLayout PathPlanner::get_layout() const {
+    return layout;
+}
+
+/**
+ * @brief Bytes of the per-level tables (cost board and landmark bounds).
+ */
+
+size_t PathPlanner::memory_bytes() const {
+    return cost.size() * sizeof(int) + bounds.size() * sizeof(int);
+}
+
+std::vector<PathResult> plan_many(const Level& level, const std::vector<PathQuery>& queries, unsigned threads){
+    PathPlanner planner(level);
+    return planner.plan_many(queries, threads);
+}
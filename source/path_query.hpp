@@ -0,0 +1,174 @@
+#ifndef PATH_QUERY_HPP
+#define PATH_QUERY_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "direction.hpp"
+
+class Level;
+
+/**
+ * @brief Core path-query API, usable without the game.
+ *
+ * Depends only on path_query, landmarks, search, level and grid: no
+ * iostream, no MouzeSimulation, no Player. To embed it in another tool,
+ * compile those five translation units (e.g. into a static library) and
+ * include this header.
+ */
+
+struct PathQuery {
+    Point start;
+    Point goal;
+};
+
+struct PathResult {
+    int cost = -1; //custo do terreno do caminho, -1 se não há caminho
+    std::vector<Dir> moves; //um passo por célula, sem a posição inicial
+};
+
+/**
+ * @brief Order of the cells in the per-cell arrays of a PathPlanner.
+ *
+ * ROW_MAJOR stores row after row, so the north and south neighbours of a
+ * cell are a whole row apart. MORTON interleaves the bits of row and
+ * column (Z-order): cells close on the board are close in memory in both
+ * directions, which keeps large searches in cache. The default is
+ * ROW_MAJOR, or MORTON when built with -DMOUZE_MORTON_LAYOUT.
+ */
+
+enum class CellLayout { ROW_MAJOR, MORTON };
+
+#ifdef MOUZE_MORTON_LAYOUT
+const CellLayout DEFAULT_CELL_LAYOUT = CellLayout::MORTON;
+#else
+const CellLayout DEFAULT_CELL_LAYOUT = CellLayout::ROW_MAJOR;
+#endif
+
+/**
+ * @brief Working memory of one thread of searches.
+ *
+ * Cells are marked with the number of the search that last touched them,
+ * so a new search does not need to clear the arrays. The arrays only grow:
+ * one scratch serves levels of any size, and once it has been sized for
+ * the largest of them (on its first query, or up front with `reserve`) it
+ * does not allocate any more, whatever the order of the levels.
+ */
+
+class PathScratch {
+    public:
+        size_t nodes_expanded = 0; //somado entre as buscas
+
+        void reserve(size_t cells);
+
+    private:
+        friend class PathPlanner;
+
+        struct Entry {
+            int f;
+            int g;
+            int cell;
+        };
+
+        std::vector<int> g;
+        std::vector<int> h; //heurística, calculada na primeira visita
+        std::vector<unsigned char> via; //direção usada para chegar na célula
+        std::vector<unsigned> stamp;
+        unsigned current = 0;
+        std::vector<Entry> open;
+        std::vector<int> goal_bounds; //linha de `bounds` do objetivo atual
+};
+
+/**
+ * @brief A* planner prepared once for a level and shared by many queries.
+ *
+ * The preprocessing (terrain cost per cell on a board padded with a wall
+ * border, ALT landmark distances stored next to each other per cell) is
+ * done in the constructor, with cells ordered by the chosen CellLayout. `plan` is const and can be called from any
+ * number of threads, each with its own PathScratch; `plan_many` answers a
+ * whole batch, optionally spread over several threads, reusing scratch
+ * kept inside the planner.
+ *
+ * In a batch, queries that share a goal are answered together: from
+ * GROUP_MIN queries on, one Dijkstra from the goal over reversed costs
+ * gives every start its path, instead of one A* per query.
+ *
+ * The level must outlive the planner only during construction; the board
+ * is copied.
+ */
+
+class PathPlanner {
+    public:
+        static constexpr int LANDMARK_COUNT = 4;
+        static constexpr size_t GROUP_MIN = 8;
+
+        explicit PathPlanner(const Level& level, int landmark_count = LANDMARK_COUNT, CellLayout layout = DEFAULT_CELL_LAYOUT);
+
+        bool plan(const PathQuery& query, PathResult& result, PathScratch& scratch) const;
+        std::vector<PathResult> plan_many(const std::vector<PathQuery>& queries, unsigned threads = 1);
+
+        size_t nodes_expanded() const;
+        size_t cell_count() const { return cost.size(); } //células com a borda, para PathScratch::reserve
+        CellLayout get_layout() const;
+        size_t memory_bytes() const;
+
+    private:
+        //linha após linha; vizinhos a um deslocamento fixo
+        struct RowMajorCells {
+            int stride; //largura com a borda
+            int offsets[4]; //deslocamento do índice para cada Dir
+
+            int index(int x, int y) const { return (x + 1) * stride + y + 1; }
+            int step(int cell, int d) const { return cell + offsets[d]; }
+            Point point(int cell) const { return {cell / stride - 1, cell % stride - 1}; }
+        };
+
+        //bits da linha nas posições ímpares, da coluna nas pares
+        struct MortonCells {
+            std::uint32_t mask_x;
+            std::uint32_t mask_y;
+
+            static std::uint32_t spread(std::uint32_t v);
+            static std::uint32_t compact(std::uint32_t v);
+            int index(int x, int y) const { return (spread(x + 1) << 1) | spread(y + 1); }
+            int step(int cell, int d) const;
+            Point point(int cell) const { return {(int)compact((std::uint32_t)cell >> 1) - 1, (int)compact(cell) - 1}; }
+        };
+
+        int rows;
+        int cols;
+        CellLayout layout;
+        RowMajorCells row_major;
+        MortonCells morton;
+        std::vector<int> cost; //custo de entrar na célula; 0 é parede
+        int landmarks = 0;
+        //por célula: distância de cada landmark até ela e dela até cada landmark
+        std::vector<int> bounds;
+        std::vector<PathScratch> scratch; //uma por thread do plan_many
+
+        int index(Point p) const;
+        unsigned begin_search(PathScratch& scratch) const;
+        bool is_open(Point p) const;
+        int heuristic(int cell, Point p, Point goal, const std::vector<int>& goal_bounds) const;
+        void distance_field(Point goal, PathScratch& scratch) const;
+        void follow_field(const PathQuery& query, PathResult& result, const PathScratch& scratch) const;
+
+        template <typename Cells> bool search(const Cells& cells, const PathQuery& query, PathResult& result, PathScratch& scratch) const;
+        template <typename Cells> void sweep(const Cells& cells, Point goal, PathScratch& scratch) const;
+        template <typename Cells> void follow(const Cells& cells, const PathQuery& query, PathResult& result, const PathScratch& scratch) const;
+};
+
+/**
+ * @brief Answers many start/goal pairs on one level in a single call.
+ *
+ * Prepares the level once and answers every query with the same planner.
+ * Keep a PathPlanner instead when batches for the same level keep coming.
+ *
+ * @param threads Threads to use; 0 uses every hardware thread.
+ * @return One result per query, in the same order.
+ */
+
+std::vector<PathResult> plan_many(const Level& level, const std::vector<PathQuery>& queries, unsigned threads = 1);
+
+#endif
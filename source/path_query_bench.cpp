@@ -0,0 +1,147 @@
+#include "benchmark.hpp"
+#include "maze.hpp"
+#include "path_query.hpp"
+#include "player.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+
+/**
+ * @brief Compares batched path queries with computed_path_A in a loop.
+ *
+ * Both use the ALT heuristic. "random" draws every start and goal;
+ * "shared" spreads the starts over a few goals, which plan_many answers
+ * with one distance field per goal. "prepare" is the one-off PathPlanner
+ * construction; the batch columns use one thread and every hardware
+ * thread. Costs must match.
+ */
+
+void bench_batch(const std::vector<Level>& levels){
+    const int queries = 2000;
+    const int goals = 20; //objetivos distintos no lote "shared"
+    const unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    std::cout << "\n[BATCHED PATH QUERIES (" << queries << " per board, " << threads << " threads)]\n";
+    std::cout << std::left << std::setw(18) << "board" << std::setw(8) << "goals" << std::right << std::setw(12) << "loop q/s"
+              << std::setw(12) << "prepare ms" << std::setw(12) << "batch q/s" << std::setw(14) << "parallel q/s"
+              << std::setw(10) << "speedup" << "\n";
+
+    for(const auto& [name, level] : terrain_boards(levels)){
+        QuerySampler sampler(level, 7);
+        if(!sampler.usable()) continue;
+
+        auto begin = Clock::now();
+        PathPlanner planner(level, Player::LANDMARK_COUNT);
+        double prepare_ms = elapsed_ms(begin);
+        Player player(level);
+
+        for(bool shared : {false, true}){
+            sampler.seed(7); //os dois lotes começam da mesma semente
+            std::vector<Point> targets(goals);
+            for(Point& target : targets){
+                target = sampler.cell();
+            }
+            std::vector<PathQuery> batch(queries);
+            for(int k=0;k<queries;++k){
+                batch[k] = {sampler.cell(), shared ? targets[k % goals] : sampler.cell()};
+            }
+
+            std::vector<int> loop_cost(queries);
+            begin = Clock::now();
+            for(int k=0;k<queries;++k){
+                player.computed_path_A(batch[k].start, batch[k].goal);
+                loop_cost[k] = player.get_valid_path() ? path_cost(level, player.path) : -1;
+            }
+            double loop_ms = elapsed_ms(begin);
+
+            planner.plan_many(batch); //aquece a memória de trabalho
+            begin = Clock::now();
+            std::vector<PathResult> single = planner.plan_many(batch);
+            double batch_ms = elapsed_ms(begin);
+            begin = Clock::now();
+            std::vector<PathResult> parallel = planner.plan_many(batch, threads);
+            double parallel_ms = elapsed_ms(begin);
+
+            size_t mismatches = 0;
+            for(int k=0;k<queries;++k){
+                if(single[k].cost != loop_cost[k] || parallel[k].cost != loop_cost[k]) ++mismatches;
+            }
+
+            std::cout << std::left << std::setw(18) << name << std::setw(8) << (shared ? std::to_string(goals) : "random")
+                      << std::right << std::fixed << std::setprecision(0)
+                      << std::setw(12) << queries / (loop_ms / 1000) << std::setw(12) << std::setprecision(2) << prepare_ms
+                      << std::setprecision(0) << std::setw(12) << queries / (batch_ms / 1000)
+                      << std::setw(14) << queries / (parallel_ms / 1000)
+                      << std::setw(9) << std::setprecision(1) << loop_ms / parallel_ms << "x\n";
+            if(mismatches){
+                std::cout << "  ! " << mismatches << " paths with different costs\n";
+            }
+        }
+    }
+}
+
+/**
+ * @brief Compares the row-major and Morton cell layouts on large mazes.
+ *
+ * The same random start/goal pairs are answered by a PathPlanner in
+ * each layout (Manhattan heuristic, so only memory order differs),
+ * followed by a few whole-board distance fields. Costs must match.
+ */
+
+void bench_layout(){
+    const int pairs = 12;
+    const int fields = 2;
+    std::cout << "\n[CELL LAYOUT: ROW-MAJOR x MORTON]\n";
+    std::cout << std::left << std::setw(14) << "maze" << std::setw(8) << "layout" << std::right
+              << std::setw(10) << "table MB" << std::setw(12) << "A* ms" << std::setw(14) << "nodes/query"
+              << std::setw(12) << "field ms" << "\n";
+
+    for(int side : {1000, 2000, 4000}){
+        Level maze = generate_maze(side, side, side + 1, 10, 30);
+        QuerySampler sampler(maze, side);
+        const std::vector<PathQuery> queries = sampler.queries(pairs);
+        std::string name = std::to_string(side) + "x" + std::to_string(side);
+
+        std::vector<int> costs;
+        for(CellLayout layout : {CellLayout::ROW_MAJOR, CellLayout::MORTON}){
+            PathPlanner planner(maze, 0, layout);
+            PathScratch scratch;
+            PathResult result;
+            planner.plan(queries.front(), result, scratch); //aloca a memória de trabalho
+
+            scratch.nodes_expanded = 0;
+            size_t mismatches = 0;
+            auto begin = Clock::now();
+            for(int k=0;k<pairs;++k){
+                planner.plan(queries[k], result, scratch);
+                if(layout == CellLayout::ROW_MAJOR){
+                    costs.push_back(result.cost);
+                }else if(costs[k] != result.cost){
+                    ++mismatches;
+                }
+            }
+            double search_ms = elapsed_ms(begin);
+            size_t nodes = scratch.nodes_expanded;
+
+            std::vector<PathQuery> to_goal(PathPlanner::GROUP_MIN);
+            begin = Clock::now();
+            for(int f=0;f<fields;++f){
+                for(PathQuery& query : to_goal){
+                    query = {sampler.cell(), queries[f].goal};
+                }
+                planner.plan_many(to_goal);
+            }
+            double field_ms = elapsed_ms(begin);
+
+            std::cout << std::left << std::setw(14) << name << std::setw(8) << (layout == CellLayout::MORTON ? "morton" : "row")
+                      << std::right << std::fixed << std::setprecision(1)
+                      << std::setw(10) << planner.memory_bytes() / 1e6 << std::setw(12) << search_ms
+                      << std::setw(14) << nodes / pairs << std::setw(12) << field_ms / fields << "\n";
+            if(mismatches){
+                std::cout << "  ! " << mismatches << " paths with different costs\n";
+            }
+        }
+    }
+}
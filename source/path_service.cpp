@@ -0,0 +1,414 @@
+#include "path_service.hpp"
+#include "search.hpp"
+#include "simulation.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <unordered_map>
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+    const size_t READ_CHUNK = 64 * 1024;
+    const int POLL_TIMEOUT_MS = 200; //intervalo para conferir se pediram para parar
+
+    std::atomic<bool> stop_requested{false};
+
+    void request_stop(int){
+        stop_requested = true;
+    }
+
+    //escreve tudo, mesmo que o sistema aceite só parte de cada vez
+    void write_all(int fd, const std::string& text){
+        size_t written = 0;
+        while(written < text.size()){
+            ssize_t n = ::write(fd, text.data() + written, text.size() - written);
+            if(n < 0 && errno == EINTR) continue;
+            if(n <= 0) return; //cliente foi embora
+            written += n;
+        }
+    }
+
+    const char MOVE_LETTERS[] = {'N', 'S', 'L', 'O'}; //na ordem de Dir
+}
+
+/**
+ * @brief Starts the worker threads.
+ *
+ * @param levels Levels the queries refer to; must outlive the service.
+ * @param threads Total number of threads answering queries, including the
+ * serving thread; 0 uses every hardware thread.
+ * @param layout Cell order of the per-level planners.
+ */
+
+PathService::PathService(const std::vector<Level>& lvls, unsigned threads, CellLayout layout) : levels(lvls){
+    if(threads == 0){
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    planners.reserve(levels.size());
+    size_t largest = 0;
+    for(const Level& level : levels){
+        planners.emplace_back(level, PathPlanner::LANDMARK_COUNT, layout);
+        largest = std::max(largest, planners.back().cell_count());
+    }
+    //do tamanho do maior nível: lotes que misturam níveis não realocam
+    scratch.resize(threads);
+    for(PathScratch& s : scratch){
+        s.reserve(largest);
+    }
+    results.resize(threads);
+    for(unsigned id=1;id<threads;++id){
+        workers.emplace_back(&PathService::worker_loop, this, id);
+    }
+}
+
+PathService::~PathService(){
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    work_ready.notify_all();
+    for(auto& worker : workers){
+        worker.join();
+    }
+}
+
+/**
+ * @brief Serves clients connected to a Unix domain socket until SIGINT,
+ * SIGTERM or a `shutdown` request.
+ *
+ * @return False if the socket could not be created.
+ */
+
+bool PathService::serve_socket(const std::string& socket_path){
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if(socket_path.size() >= sizeof(address.sun_path)){
+        return false;
+    }
+    std::strcpy(address.sun_path, socket_path.c_str());
+
+    int listener = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if(listener < 0){
+        return false;
+    }
+    ::unlink(socket_path.c_str());
+    if(::bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 || ::listen(listener, SOMAXCONN) < 0){
+        ::close(listener);
+        return false;
+    }
+
+    serve(listener);
+    ::close(listener);
+    ::unlink(socket_path.c_str());
+    return true;
+}
+
+/**
+ * @brief Serves requests read from standard input, answering on standard
+ * output, until the input ends or a `shutdown` request.
+ */
+
+void PathService::serve_stdio(){
+    std::cout.flush();
+    serve(-1);
+}
+
+/**
+ * @brief Event loop shared by both modes.
+ *
+ * Each round waits for input, reads what every client sent and answers all
+ * complete lines received in the round as one batch.
+ *
+ * @param listener Listening socket, or -1 to use standard input.
+ */
+
+void PathService::serve(int listener){
+    stop_requested = false;
+    auto previous_int = std::signal(SIGINT, request_stop);
+    auto previous_term = std::signal(SIGTERM, request_stop);
+    auto previous_pipe = std::signal(SIGPIPE, SIG_IGN);
+
+    std::vector<pollfd> fds;
+    fds.push_back({listener >= 0 ? listener : STDIN_FILENO, POLLIN, 0});
+    std::unordered_map<int, std::string> pending; //linha incompleta de cada cliente
+    std::vector<Query> queries;
+    std::string chunk(READ_CHUNK, '\0');
+    bool running = true;
+
+    while(running && !stop_requested){
+        int ready = ::poll(fds.data(), fds.size(), POLL_TIMEOUT_MS);
+        if(ready < 0 && errno == EINTR) continue;
+        if(ready < 0) break;
+        if(ready == 0) continue;
+
+        const auto now = Clock::now();
+        //clientes (na entrada padrão, o próprio fds[0])
+        for(size_t i = fds.size(); i-- > (listener >= 0 ? 1 : 0);){
+            if(!(fds[i].revents & (POLLIN | POLLHUP | POLLERR))) continue;
+            const int fd = fds[i].fd;
+            ssize_t n = ::read(fd, chunk.data(), chunk.size());
+            if(n <= 0){
+                //última linha sem '\n' no fim da entrada
+                auto rest = pending.find(fd);
+                if(rest != pending.end() && !rest->second.empty() && rest->second != "shutdown"){
+                    queries.push_back({fd, std::move(rest->second), now, ""});
+                }
+                pending.erase(fd);
+                if(listener < 0){
+                    running = false;
+                    break;
+                }
+                ::close(fd);
+                fds.erase(fds.begin() + i);
+                continue;
+            }
+
+            std::string& buffer = pending[fd];
+            buffer.append(chunk.data(), n);
+            size_t begin = 0;
+            for(size_t end = buffer.find('\n'); end != std::string::npos; end = buffer.find('\n', begin)){
+                std::string line = buffer.substr(begin, end - begin);
+                begin = end + 1;
+                if(line == "shutdown"){
+                    running = false;
+                }else if(!line.empty()){
+                    queries.push_back({fd, std::move(line), now, ""});
+                }
+            }
+            buffer.erase(0, begin);
+        }
+
+        if(listener >= 0 && (fds[0].revents & POLLIN)){
+            int client = ::accept(listener, nullptr, nullptr);
+            if(client >= 0){
+                fds.push_back({client, POLLIN, 0});
+            }
+        }
+
+        if(queries.empty()) continue;
+        run_batch(queries);
+
+        //uma escrita por cliente, com as respostas na ordem dos pedidos
+        std::unordered_map<int, std::string> out;
+        for(const Query& query : queries){
+            out[query.client] += query.answer + "\n";
+        }
+        for(const auto& [fd, text] : out){
+            write_all(listener >= 0 ? fd : STDOUT_FILENO, text);
+        }
+        record(queries);
+        queries.clear();
+    }
+
+    if(listener >= 0){
+        for(size_t i=1;i<fds.size();++i){
+            ::close(fds[i].fd);
+        }
+    }
+    std::signal(SIGINT, previous_int);
+    std::signal(SIGTERM, previous_term);
+    std::signal(SIGPIPE, previous_pipe);
+}
+
+/**
+ * @brief Answers a batch of queries on every thread of the pool.
+ */
+
+void PathService::run_batch(std::vector<Query>& queries){
+    batch = &queries;
+    next_query = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++generation;
+        busy = workers.size();
+    }
+    work_ready.notify_all();
+    answer_queries(0);
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        work_done.wait(lock, [this]{ return busy == 0; });
+    }
+    batch = nullptr;
+}
+
+void PathService::worker_loop(unsigned id){
+    size_t seen = 0;
+    while(true){
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            work_ready.wait(lock, [&]{ return stopping || generation != seen; });
+            if(stopping) return;
+            seen = generation;
+        }
+        answer_queries(id);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if(--busy == 0){
+                work_done.notify_one();
+            }
+        }
+    }
+}
+
+/**
+ * @brief Answers from path databases instead of A*, one per level in level
+ * order. Must be called before serving.
+ */
+
+void PathService::use_databases(std::vector<PathDatabase> tables){
+    databases = std::move(tables);
+}
+
+void PathService::answer_queries(unsigned id){
+    std::vector<Query>& queries = *batch;
+    for(size_t i = next_query++; i < queries.size(); i = next_query++){
+        queries[i].answer = answer(id, queries[i].line);
+    }
+}
+
+/**
+ * @brief Answers one request line with the scratch of thread `id`.
+ */
+
+std::string PathService::answer(unsigned id, const std::string& line){
+    std::istringstream request(line);
+    std::string query_id;
+    long level_number;
+    Point start, goal;
+    if(!(request >> query_id >> level_number >> start.x >> start.y >> goal.x >> goal.y)){
+        return (query_id.empty() ? "?" : query_id) + " error malformed request";
+    }
+    if(level_number < 1 || level_number > (long)levels.size()){
+        return query_id + " error unknown level";
+    }
+
+    const Level& level = levels[level_number - 1];
+    if(!is_open_cell(level, start.x, start.y) || !is_open_cell(level, goal.x, goal.y)){
+        return query_id + " error start or goal is not an open cell";
+    }
+
+    PathResult& result = results[id];
+    const bool found = databases.empty()
+        ? planners[level_number - 1].plan({start, goal}, result, scratch[id])
+        : databases[level_number - 1].plan({start, goal}, result);
+    if(!found){
+        return query_id + " -1";
+    }
+
+    std::string moves;
+    moves.reserve(result.moves.size());
+    for(Dir move : result.moves){
+        moves += MOVE_LETTERS[move];
+    }
+    return query_id + " " + std::to_string(result.cost) + " " + moves;
+}
+
+void PathService::record(const std::vector<Query>& queries){
+    const auto now = Clock::now();
+    if(latencies_ms.empty()){
+        first_query = queries.front().received;
+    }
+    for(const Query& query : queries){
+        latencies_ms.push_back(std::chrono::duration<double, std::milli>(now - query.received).count());
+    }
+    last_answer = now;
+    ++batches;
+}
+
+/**
+ * @brief Prints throughput and latency of the queries answered so far.
+ *
+ * Latency goes from the round in which a request was read to the moment
+ * its batch was written back.
+ */
+
+void PathService::report(std::ostream& out) const{
+    out << "\n[PATH SERVICE]\n";
+    out << "  threads: " << scratch.size() << ", queries: " << latencies_ms.size() << ", batches: " << batches << "\n";
+    if(latencies_ms.empty()){
+        return;
+    }
+
+    std::vector<double> sorted = latencies_ms;
+    std::sort(sorted.begin(), sorted.end());
+    auto percentile = [&](double p){
+        return sorted[std::min(sorted.size() - 1, (size_t)(p * sorted.size()))];
+    };
+    double seconds = std::chrono::duration<double>(last_answer - first_query).count();
+
+    out << std::fixed << std::setprecision(3);
+    out << "  mean batch: " << (double)sorted.size() / batches << " queries\n";
+    if(seconds > 0){
+        out << "  throughput: " << std::setprecision(0) << sorted.size() / seconds << " queries/s\n" << std::setprecision(3);
+    }
+    out << "  latency ms: p50 " << percentile(0.50) << ", p99 " << percentile(0.99) << ", max " << sorted.back() << "\n";
+}
+
+/**
+ * @brief Runs the path service selected with --serve on the loaded levels.
+ *
+ * "-" serves standard input/output (the report then goes to standard
+ * error); anything else is the path of a Unix domain socket.
+ */
+
+void MouzeSimulation::run_service(){
+    PathService service(levels, 0, cell_layout);
+    const bool stdio = serve_target == "-";
+
+    //tabelas de --build-db ao lado do .dat, se ainda valem para estes níveis
+    std::vector<PathDatabase> databases;
+    const std::string database_filename = path_database_filename(level_filename);
+    if(!level_filename.empty() && read_path_databases(database_filename, levels, databases)){
+        std::cout << "Info: Answering from path database " << database_filename << ".\n";
+        service.use_databases(std::move(databases));
+    }
+
+    if(stdio){
+        service.serve_stdio();
+    }else{
+        std::cout << "Info: Serving " << levels.size() << " levels on " << serve_target << " (Ctrl+C to stop).\n" << std::flush;
+        if(!service.serve_socket(serve_target)){
+            std::cout << "Error: Could not listen on " << serve_target << ".\n";
+            exit(1);
+        }
+    }
+    service.report(stdio ? std::cerr : std::cout);
+}
+
+/**
+ * @brief Builds the path database of every loaded level on all cores and
+ * writes it next to the level file (--build-db).
+ */
+
+void MouzeSimulation::build_path_databases(){
+    if(level_filename.empty()){
+        std::cout << "Error: --build-db needs a level file to write the database next to.\n";
+        exit(1);
+    }
+
+    auto begin = std::chrono::steady_clock::now();
+    std::vector<PathDatabase> databases(levels.size());
+    size_t bytes = 0;
+    for(size_t i = 0; i < levels.size(); ++i){
+        databases[i].build(levels[i]);
+        bytes += databases[i].memory_bytes();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+    const std::string filename = path_database_filename(level_filename);
+    if(!write_path_databases(filename, databases)){
+        std::cout << "Error: Could not write " << filename << ".\n";
+        exit(1);
+    }
+    std::cout << "Info: Path database of " << levels.size() << " levels written to " << filename
+              << " (" << bytes / 1024.0 << " KiB in memory, built in " << seconds << " s).\n";
+}
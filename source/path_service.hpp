@@ -0,0 +1,89 @@
+#ifndef PATH_SERVICE_HPP
+#define PATH_SERVICE_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <ostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "level.hpp"
+#include "path_query.hpp"
+#include "path_database.hpp"
+
+/**
+ * @brief Answers path queries on the loaded levels, without a game.
+ *
+ * Protocol, one line per message:
+ * - request: `<id> <level> <start row> <start col> <goal row> <goal col>`,
+ *   with levels numbered from 1 in file order;
+ * - answer: `<id> <cost> <moves>`, where moves has one letter per step
+ *   (N, S, L or O, as in Dir); `<id> -1` when the goal cannot be reached
+ *   and `<id> error <reason>` for a bad request;
+ * - `shutdown` stops the service (end of input does the same on stdin).
+ *
+ * Requests that arrive together are answered as one batch, shared out to a
+ * pool of worker threads (the serving thread also works). Each level is
+ * prepared once in a shared PathPlanner and each thread keeps its own
+ * PathScratch, so the A* memory is reused between queries. With path
+ * databases (use_databases) the levels they cover are answered from the
+ * first-move tables instead, without a search.
+ */
+
+class PathService {
+    public:
+        PathService(const std::vector<Level>& levels, unsigned threads = 0, CellLayout layout = DEFAULT_CELL_LAYOUT);
+        ~PathService();
+        PathService(const PathService&) = delete;
+        PathService& operator=(const PathService&) = delete;
+
+        bool serve_socket(const std::string& socket_path);
+        void serve_stdio();
+        void use_databases(std::vector<PathDatabase> tables);
+        void report(std::ostream& out) const;
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        struct Query {
+            int client; //descritor de onde veio o pedido
+            std::string line;
+            Clock::time_point received;
+            std::string answer;
+        };
+
+        const std::vector<Level>& levels;
+        std::vector<PathPlanner> planners; //um por nível
+        std::vector<PathDatabase> databases; //um por nível, ou vazio para usar o A*
+        std::vector<PathScratch> scratch; //um por thread
+        std::vector<PathResult> results; //um por thread
+
+        std::vector<std::thread> workers;
+        std::mutex mutex;
+        std::condition_variable work_ready;
+        std::condition_variable work_done;
+        size_t generation = 0;
+        unsigned busy = 0;
+        bool stopping = false;
+
+        std::vector<Query>* batch = nullptr;
+        std::atomic<size_t> next_query{0};
+
+        //estatísticas
+        std::vector<double> latencies_ms;
+        size_t batches = 0;
+        Clock::time_point first_query;
+        Clock::time_point last_answer;
+
+        void serve(int listener);
+        void run_batch(std::vector<Query>& queries);
+        void worker_loop(unsigned id);
+        void answer_queries(unsigned id);
+        std::string answer(unsigned id, const std::string& line);
+        void record(const std::vector<Query>& queries);
+};
+
+#endif
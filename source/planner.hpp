@@ -0,0 +1,294 @@
+#ifndef PLANNER_HPP
+#define PLANNER_HPP
+
+#include <string>
+#include <tuple>
+
+#include "player.hpp"
+#include "direction.hpp"
+#include "compact_path.hpp"
+#include "path_cache.hpp"
+#include "trace.hpp"
+
+/**
+ * @brief Path planners available to the simulation.
+ *
+ * Each planner is a stateless type exposing:
+ * - `name`: value accepted by --playertype / playertype;
+ * - `replan_on_food`: whether a new path is computed after each pellet
+ *   (false when one path already covers every pellet);
+ * - `all_food`: whether the planner needs every pellet on the board at once;
+ * - `optimal`: whether its path to a single pellet always has the least
+ *   terrain cost (checked by --bench verify);
+ * - `randomized`: whether its paths depend on random choices, so their
+ *   cost is not compared between runs;
+ * - `anytime`: whether it also has `improve(player, head)`, called on the
+ *   ticks between plans to refine the path being walked (true when a
+ *   better path was put in `player.path`);
+ * - `plan(player, head)`: fills `player.path` with the cells to walk,
+ *   excluding the head position.
+ *
+ * To add a planner, declare its type here and append it to `PlannerList`;
+ * the simulation binds the chosen one at startup (see resolve_planner).
+ */
+
+struct RandomPlanner {
+    static constexpr const char* name = "random";
+    static constexpr bool replan_on_food = true;
+    static constexpr bool all_food = false;
+    static constexpr bool optimal = false;
+    static constexpr bool randomized = true;
+    static constexpr bool anytime = false;
+
+    static void plan(Player& player, Point head){
+        player.path.clear();
+        player.path.push_back(player.computed_random(head));
+    }
+};
+
+struct BacktrackingPlanner {
+    static constexpr const char* name = "backtracking";
+    static constexpr bool replan_on_food = true;
+    static constexpr bool all_food = false;
+    static constexpr bool optimal = false;
+    static constexpr bool randomized = false;
+    static constexpr bool anytime = false;
+
+    static void plan(Player& player, Point head){
+        player.computed_path_bt(head);
+    }
+};
+
+struct AStarPlanner {
+    static constexpr const char* name = "A*";
+    static constexpr bool replan_on_food = true;
+    static constexpr bool all_food = false;
+    static constexpr bool optimal = true;
+    static constexpr bool randomized = false;
+    static constexpr bool anytime = false;
+
+    static void plan(Player& player, Point head){
+        player.computed_path_A(head);
+    }
+};
+
+struct ParallelAStarPlanner {
+    static constexpr const char* name = "parallelA*";
+    static constexpr bool replan_on_food = true;
+    static constexpr bool all_food = false;
+    static constexpr bool optimal = true;
+    static constexpr bool randomized = false;
+    static constexpr bool anytime = false;
+
+    static void plan(Player& player, Point head){
+        player.computed_path_parallel_A(head);
+    }
+};
+
+struct CorridorPlanner {
+    static constexpr const char* name = "corridor";
+    static constexpr bool replan_on_food = true;
+    static constexpr bool all_food = false;
+    static constexpr bool optimal = true;
+    static constexpr bool randomized = false;
+    static constexpr bool anytime = false;
+
+    static void plan(Player& player, Point head){
+        player.computed_path_corridor(head);
+    }
+};
+
+struct TourPlanner {
+    static constexpr const char* name = "tour";
+    static constexpr bool replan_on_food = false;
+    static constexpr bool all_food = true;
+    static constexpr bool optimal = true;
+    static constexpr bool randomized = false;
+    static constexpr bool anytime = false;
+
+    static void plan(Player& player, Point head){
+        player.computed_path_tour(head);
+    }
+};
+
+struct MonteCarloPlanner {
+    static constexpr const char* name = "montecarlo";
+    static constexpr bool replan_on_food = true;
+    static constexpr bool all_food = false;
+    static constexpr bool optimal = false;
+    static constexpr bool randomized = true;
+    static constexpr bool anytime = false;
+
+    static void plan(Player& player, Point head){
+        player.computed_path_montecarlo(head);
+    }
+};
+
+struct AnytimeAStarPlanner {
+    static constexpr const char* name = "ARA*";
+    static constexpr bool replan_on_food = true;
+    static constexpr bool all_food = false;
+    static constexpr bool optimal = false;
+    static constexpr bool randomized = false;
+    static constexpr bool anytime = true;
+
+    static void plan(Player& player, Point head){
+        player.computed_path_ara(head);
+    }
+
+    static bool improve(Player& player, Point head){
+        return player.improve_path_ara(head);
+    }
+};
+
+struct IdaStarPlanner {
+    static constexpr const char* name = "IDA*";
+    static constexpr bool replan_on_food = true;
+    static constexpr bool all_food = false;
+    static constexpr bool optimal = true;
+    static constexpr bool randomized = false;
+    static constexpr bool anytime = false;
+
+    static void plan(Player& player, Point head){
+        player.computed_path_ida(head);
+    }
+};
+
+using PlannerList = std::tuple<RandomPlanner, BacktrackingPlanner, AStarPlanner, ParallelAStarPlanner, AnytimeAStarPlanner, IdaStarPlanner, CorridorPlanner, TourPlanner, MonteCarloPlanner>;
+
+template <typename Planner>
+struct PlannerTag {
+    using type = Planner;
+};
+
+/**
+ * @brief Finds the planner registered under a name.
+ *
+ * Calls `bind(PlannerTag<Planner>{})` for the matching planner type so the
+ * caller can instantiate code for it; nothing is called if no planner has
+ * that name.
+ *
+ * @return True if a planner was found.
+ */
+
+template <typename Binder, size_t I = 0>
+bool resolve_planner(const std::string& name, Binder&& bind){
+    if constexpr (I < std::tuple_size_v<PlannerList>) {
+        using Planner = std::tuple_element_t<I, PlannerList>;
+        if(name == Planner::name){
+            bind(PlannerTag<Planner>{});
+            return true;
+        }
+        return resolve_planner<Binder, I + 1>(name, std::forward<Binder>(bind));
+    }else{
+        return false;
+    }
+}
+
+/**
+ * @brief Names of every registered planner, separated by commas.
+ */
+
+template <size_t I = 0>
+std::string planner_names(){
+    if constexpr (I < std::tuple_size_v<PlannerList>) {
+        std::string rest = planner_names<I + 1>();
+        return std::string(std::tuple_element_t<I, PlannerList>::name) + (rest.empty() ? "" : ", " + rest);
+    }else{
+        return "";
+    }
+}
+
+/**
+ * @brief Calls `visit(PlannerTag<Planner>{})` for every registered planner,
+ * in the order of PlannerList.
+ */
+
+template <typename Visitor>
+void for_each_planner(Visitor&& visit){
+    std::apply([&](auto... planners){ (visit(PlannerTag<decltype(planners)>{}), ...); }, PlannerList{});
+}
+
+/**
+ * @brief Path a game is walking and the cell it takes next.
+ */
+
+struct RouteWalk {
+    CompactPath route; //trocado com o do jogador a cada plano
+    CompactPath::Cursor step; //próxima célula de `route`
+    bool replan = true; //pede um novo plano no próximo passo
+    PathCache* cache = nullptr; //caminhos já planejados; nulo para sempre planejar
+    std::uint32_t level = 0; //nível das chaves do cache
+};
+
+/**
+ * @brief What one step of the head found.
+ *
+ * WAITING: an anytime planner has no path yet and asks for another tick;
+ * STUCK: any other planner gave no path, so the head stays where it is.
+ */
+
+enum class StepResult { MOVED, ATE, CRASHED, WAITING, STUCK };
+
+/**
+ * @brief Moves the head one cell along the walked path with a given planner.
+ *
+ * Asks the planner for a new path when the current one ran out (or a pellet
+ * was eaten and the planner replans per pellet); anytime planners use the
+ * steps in between to improve the path being walked. With a cache, the
+ * paths of deterministic planners towards the single pellet on the board
+ * (level.food_mouse) are looked up first; the caller must not set one when
+ * several pellets are on the board. The pellet eaten is
+ * cleared from the board; nothing else of the game is changed.
+ */
+
+template <typename Planner>
+StepResult walk_route(Player& player, Level& level, Point& head, RouteWalk& walk){
+    if(walk.replan || walk.step.done()){
+        TRACE_SCOPE(Planner::name);
+        constexpr bool cacheable = !Planner::randomized && !Planner::anytime && !Planner::all_food;
+        const PathKey key{walk.level, head, level.food_mouse, Planner::name};
+        if(!cacheable || walk.cache == nullptr || !walk.cache->find(key, walk.route)){
+            Planner::plan(player, head);
+            player.take_route(head, walk.route);
+            if(cacheable && walk.cache != nullptr){
+                walk.cache->store(key, walk.route);
+            }
+        }
+        walk.step = walk.route.begin();
+        walk.replan = false;
+    }else if constexpr (Planner::anytime){
+        //entre um plano e outro, o tempo do tick melhora o caminho atual
+        TRACE_SCOPE(Planner::name);
+        if(Planner::improve(player, head)){
+            player.take_route(head, walk.route);
+            walk.step = walk.route.begin();
+        }
+    }
+
+    if(walk.step.done()){
+        //o planejador anytime pode ainda não ter caminho: tenta de novo no próximo tick
+        return Planner::anytime ? StepResult::WAITING : StepResult::STUCK;
+    }
+
+    Point next = walk.step.next();
+    char cell = level.get_cell(level, next);
+
+    StepResult result = StepResult::CRASHED;
+    if(level.is_empty_cell(cell)){
+        result = StepResult::MOVED;
+        head = next;
+    }else if(level.is_food(cell)){
+        result = StepResult::ATE;
+        head = next;
+        level.current_mouse = head;
+        level.update_board_after_food(); // para limpar a comida
+        if(Planner::replan_on_food){
+            walk.replan = true;
+        }
+    }
+    TRACE_POINT("head", head.x, head.y);
+    return result;
+}
+
+#endif
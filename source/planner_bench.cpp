@@ -0,0 +1,270 @@
+#include "benchmark.hpp"
+#include "level_reader.hpp"
+#include "planner.hpp"
+#include "search.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <unordered_map>
+
+namespace {
+    //limites de regressão em relação ao arquivo de referência
+    const double TIME_TOLERANCE = 0.5; //tempo pode variar com a máquina
+    const double TIME_SLACK_MS = 2.0; //diferenças menores que isto são ruído
+    const double COUNT_TOLERANCE = 0.05; //nós expandidos e custo
+    const double RANDOM_REACHED_TOLERANCE = 0.5; //chegadas dos planejadores aleatórios
+
+    struct VerifyTotals {
+        int queries = 0;
+        int reached = 0;
+        int errors = 0;
+        long cost = 0; //custo andado nas consultas que chegaram à comida
+        long optimal_cost = 0; //custo mínimo dessas mesmas consultas
+        size_t nodes = 0;
+        double ms = 0;
+    };
+
+    /**
+     * @brief Walks a planner from start to goal on random pairs of every board.
+     *
+     * The planner is called again whenever its path runs out, as in the
+     * THINKING state, until the pellet is eaten or the walk gets 20 times
+     * longer than the shortest path. Every step must go to a neighbouring
+     * open cell; optimal planners must also reach the pellet with the cost
+     * of a reference Dijkstra. Problems are printed and counted in `errors`.
+     * Goals are plain floor, as in generate_food: a pellet on '@' or '%'
+     * would hide the terrain the landmarks were built with.
+     */
+
+    template <typename Planner>
+    VerifyTotals verify_planner(std::vector<BenchBoard>& boards){
+        const int pairs = 10;
+        VerifyTotals totals;
+
+        for(auto& [name, level] : boards){
+            QuerySampler sampler(level, 7);
+            if(!sampler.usable()) continue;
+
+            Player player(level);
+            std::vector<int> dist;
+
+            for(int k=0;k<pairs;++k){
+                const auto [start, goal] = sampler.query();
+                if(start == goal || level.board[goal.x][goal.y] != ' ') continue;
+
+                //a comida conta como chão comum, então a distância é medida com ela no lugar
+                const char saved = level.board[goal.x][goal.y];
+                level.board[goal.x][goal.y] = '*';
+                level.food_mouse = goal;
+                dijkstra(level, start, dist);
+                const int shortest = dist[goal.x * level.cols + goal.y];
+                if(shortest == UNREACHABLE){
+                    level.board[goal.x][goal.y] = saved;
+                    continue;
+                }
+
+                Point head = start;
+                long cost = 0;
+                int steps = 0;
+                const int limit = 20 * shortest + 100;
+                bool valid = true;
+                while(valid && !(head == goal) && steps < limit){
+                    player.nodes_expanded = 0;
+                    auto begin = Clock::now();
+                    Planner::plan(player, head);
+                    totals.ms += elapsed_ms(begin);
+                    totals.nodes += player.nodes_expanded;
+                    if(player.path.empty()) break;
+
+                    for(const Point& next : player.path){
+                        bool adjacent = std::abs(next.x - head.x) + std::abs(next.y - head.y) == 1;
+                        if(!adjacent || !is_open_cell(level, next.x, next.y)){
+                            std::cout << "  ! " << Planner::name << " on " << name << ": invalid step ("
+                                      << head.x << "," << head.y << ") -> (" << next.x << "," << next.y << ")\n";
+                            valid = false;
+                            break;
+                        }
+                        cost += level.terrain_cost(level.board[next.x][next.y]);
+                        head = next;
+                        if(head == goal || ++steps >= limit) break;
+                    }
+                }
+                level.board[goal.x][goal.y] = saved;
+
+                ++totals.queries;
+                bool reached = valid && head == goal;
+                if(reached){
+                    ++totals.reached;
+                    totals.cost += cost;
+                    totals.optimal_cost += shortest;
+                }
+                if(!valid || (Planner::optimal && (!reached || cost != shortest))){
+                    if(valid){
+                        std::cout << "  ! " << Planner::name << " on " << name << ": (" << start.x << "," << start.y
+                                  << ") -> (" << goal.x << "," << goal.y << ") cost " << (reached ? std::to_string(cost) : "-")
+                                  << ", shortest " << shortest << "\n";
+                    }
+                    ++totals.errors;
+                }
+            }
+        }
+        return totals;
+    }
+
+    /**
+     * @brief Adds the valid levels of the other .dat files in the directory
+     * of `loaded_file` to `boards`, skipping boards that are already there.
+     *
+     * The directory comes from the level file, not from the working
+     * directory, so the boards checked do not depend on where the program
+     * was started.
+     *
+     * @return False (after printing why) when there is no level file or its
+     * directory cannot be listed.
+     */
+
+    bool add_sibling_boards(std::vector<BenchBoard>& boards, const std::string& loaded_file){
+        if(loaded_file.empty()){
+            std::cout << "  Error: verify needs a level file; the other .dat files of its directory are checked too.\n";
+            return false;
+        }
+        std::filesystem::path directory = std::filesystem::path(loaded_file).parent_path();
+        if(directory.empty()){
+            directory = ".";
+        }
+
+        std::error_code error;
+        std::vector<std::filesystem::path> files;
+        std::filesystem::directory_iterator entries(directory, error);
+        if(error){
+            std::cout << "  Error: could not list " << directory.string() << ": " << error.message() << "\n";
+            return false;
+        }
+        for(const auto& entry : entries){
+            if(entry.path().extension() == ".dat"){
+                files.push_back(entry.path());
+            }
+        }
+        std::sort(files.begin(), files.end()); //ordem fixa para a referência
+
+        std::set<std::vector<std::string>> seen;
+        std::vector<std::string> rows;
+        for(const auto& [name, level] : boards){
+            level.board.copy_to(rows);
+            seen.insert(rows);
+        }
+        for(const std::filesystem::path& file : files){
+            if(std::filesystem::equivalent(file, loaded_file, error)) continue;
+            std::ifstream in(file);
+            std::vector<LevelRecord> records = read_all_levels(in);
+            for(size_t i=0;i<records.size();++i){
+                if(records[i].status != ReadStatus::LOADED) continue;
+                records[i].level.board.copy_to(rows);
+                if(!seen.insert(rows).second) continue;
+                boards.push_back({file.filename().string() + " " + std::to_string(i + 1), std::move(records[i].level)});
+            }
+        }
+        return true;
+    }
+}
+
+/**
+ * @brief Checks every planner and compares it with a reference file.
+ *
+ * Runs verify_planner for each registered planner on the loaded levels,
+ * the levels of the other .dat files next to the level file (see
+ * add_sibling_boards) and generated mazes. With a
+ * baseline file, time, nodes expanded and (for planners that are not
+ * randomized) path cost must not grow past the tolerances above, and
+ * the number of queries that reached the pellet must not change
+ * (randomized planners may lose up to RANDOM_REACHED_TOLERANCE of
+ * them). If the file does not exist it is written with the current
+ * results.
+ *
+ * @return False on invalid or non-optimal paths or on a regression.
+ */
+
+bool bench_verify(const std::vector<Level>& levels, const std::string& level_filename, const std::string& baseline_filename){
+    auto boards = terrain_boards(levels);
+    if(!add_sibling_boards(boards, level_filename)){
+        std::cout << "  FAILED\n";
+        return false;
+    }
+
+    //linha: nome ms nós custo consultas chegadas
+    std::unordered_map<std::string, VerifyTotals> baseline;
+    std::ifstream baseline_in(baseline_filename);
+    const bool compare = !baseline_filename.empty() && baseline_in.is_open();
+    std::string line;
+    while(compare && std::getline(baseline_in, line)){
+        std::istringstream fields(line);
+        std::string name;
+        VerifyTotals entry;
+        entry.queries = -1; //referência antiga, sem contagem de chegadas
+        if(fields >> name >> entry.ms >> entry.nodes >> entry.cost){
+            if(!(fields >> entry.queries >> entry.reached)){
+                entry.queries = -1;
+            }
+            baseline[name] = entry;
+        }
+    }
+
+    std::cout << "\n[PLANNER VERIFICATION (" << boards.size() << " boards";
+    if(compare) std::cout << ", baseline " << baseline_filename;
+    std::cout << ")]\n";
+    std::cout << std::left << std::setw(14) << "planner" << std::right << std::setw(9) << "queries"
+              << std::setw(9) << "reached" << std::setw(10) << "excess" << std::setw(10) << "nodes"
+              << std::setw(10) << "ms" << std::setw(8) << "errors" << "  status\n";
+
+    bool ok = true;
+    std::ostringstream results;
+    auto run = [&](auto tag){
+        using Planner = typename decltype(tag)::type;
+        VerifyTotals totals = verify_planner<Planner>(boards);
+        results << Planner::name << " " << totals.ms << " " << totals.nodes << " " << totals.cost
+                << " " << totals.queries << " " << totals.reached << "\n";
+
+        std::string status = totals.errors ? "FAIL" : "ok";
+        auto found = baseline.find(Planner::name);
+        if(compare && found != baseline.end()){
+            const VerifyTotals& base = found->second;
+            if(totals.ms > base.ms * (1 + TIME_TOLERANCE) && totals.ms - base.ms > TIME_SLACK_MS){
+                status = "SLOWER";
+            }
+            if(totals.nodes > base.nodes * (1 + COUNT_TOLERANCE)){
+                status = "MORE NODES";
+            }
+            if(!Planner::randomized && totals.cost > base.cost * (1 + COUNT_TOLERANCE)){
+                status = "LONGER PATHS";
+            }
+            //o custo só soma as consultas que chegaram: menos chegadas também baixam o custo
+            if(Planner::randomized ? totals.reached < base.reached * (1 - RANDOM_REACHED_TOLERANCE) : totals.reached != base.reached){
+                status = "REACHED " + std::to_string(base.reached) + "->" + std::to_string(totals.reached);
+            }
+            if(base.queries != totals.queries){
+                status = base.queries < 0 ? "OLD BASELINE" : "OTHER BOARDS";
+            }
+        }
+        ok = ok && status == "ok";
+
+        double excess = totals.optimal_cost ? 100.0 * (totals.cost - totals.optimal_cost) / totals.optimal_cost : 0.0;
+        std::cout << std::left << std::setw(14) << Planner::name << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(9) << totals.queries << std::setw(9) << totals.reached
+                  << std::setw(9) << excess << "%" << std::setw(10) << totals.nodes
+                  << std::setw(10) << totals.ms << std::setw(8) << totals.errors << "  " << status << "\n";
+    };
+    for_each_planner(run);
+
+    if(!baseline_filename.empty() && !compare){
+        std::ofstream baseline_out(baseline_filename);
+        baseline_out << results.str();
+        std::cout << "  baseline written to " << baseline_filename << "\n";
+    }
+    std::cout << (ok ? "  PASSED\n" : "  FAILED\n");
+    return ok;
+}
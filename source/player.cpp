@@ -1,4 +1,6 @@
 #include "player.hpp"
+#include "trace.hpp"
+#include "search.hpp"
 
 #include <iostream>
 
@@ -6,15 +8,15 @@
 /**
  * @brief Checks whether a given position is a valid cell for the snake to move to.
  * 
+ * Same rule as is_open_cell, used by every other search: cells past the
+ * end of a short row are walls.
+ * 
  * @param p Point to check.
  * @return True if the position is within bounds and not a wall or snake body.
  */
 
 bool Player::is_valid(const Point& p) const{
-    if(p.x >= 0 && p.y >= 0 && p.x < level.rows && p.y < level.cols && level.board[p.x][p.y] != '#'){
-        return true;
-    }
-    return false;
+    return is_open_cell(level, p.x, p.y);
 }
 
 
@@ -22,7 +24,7 @@ bool Player::is_valid(const Point& p) const{
  * @brief Computes a valid path to the food using backtracking.
  * 
  * Starts from the snake's head and explores valid paths using a stack.
- * If a path to the food is found, it stores the path and directions.
+ * If a path to the food is found, it stores the path.
  * If no path is found, it chooses a random valid direction.
  * 
  * @param head_mouse Current position of the snake's head.
@@ -30,33 +32,34 @@ bool Player::is_valid(const Point& p) const{
 
 void Player::computed_path_bt(Point head_mouse){
     path.clear();
-    path_direction.clear();
     path_valid = false;
 
-    std::stack<PathUnit> place_to_visit;
-    std::set<Point> visited;
+    arena.reset();
+
+    //nós da árvore de busca e pilha de índices, ambos na arena
+    std::pmr::vector<PathUnit> nodes(&arena);
+    std::pmr::vector<int> place_to_visit(&arena);
+    std::pmr::vector<char> visited(level.rows * level.cols, 0, &arena);
 
     //ponto de inicio
-    place_to_visit.push({head_mouse, {}});
+    nodes.push_back({head_mouse, -1, Dir::N});
+    place_to_visit.push_back(0);
 
     while (!place_to_visit.empty()) {
-        PathUnit current = place_to_visit.top();
-        place_to_visit.pop();
+        int current = place_to_visit.back();
+        place_to_visit.pop_back();
 
-        Point current_pos = current.current_pos;
+        Point current_pos = nodes[current].current_pos;
+        int cell = current_pos.x * level.cols + current_pos.y;
 
-        if (visited.count(current_pos)) continue;
-        visited.insert(current_pos);
+        if (visited[cell]) continue;
+        visited[cell] = 1;
         if (level.board[current_pos.x][current_pos.y] == '*') {
-            //armazenar o caminho e a direção até a comida
-            Point step = head_mouse; 
-            for (Dir direction : current.path) {
-                //preencher vetor de direções p direcionar a cabeça
-                path_direction.push_back(direction);
-                step.x += MOVES[static_cast<int>(direction)].x;
-                step.y += MOVES[static_cast<int>(direction)].y;
-                path.push_back(step);
+            //armazenar o caminho até a comida, voltando pelos pais
+            for (int n = current; nodes[n].parent != -1; n = nodes[n].parent) {
+                path.push_back(nodes[n].current_pos);
             }
+            std::reverse(path.begin(), path.end());
             path_valid = true;
             return;
         }
@@ -68,19 +71,15 @@ void Player::computed_path_bt(Point head_mouse){
                 current_pos.y + MOVES[i].y
             };
 
-            if (is_valid(next_pos) && !visited.count(next_pos)) {
-                PathUnit next_unit = current;
-                next_unit.current_pos = next_pos;
-                next_unit.path.push_back(d);
-                place_to_visit.push(next_unit);
+            if (is_valid(next_pos) && !visited[next_pos.x * level.cols + next_pos.y]) {
+                nodes.push_back({next_pos, current, d});
+                place_to_visit.push_back(nodes.size() - 1);
             }
         }
     }
 
     if(not path_valid){
         Point random_pos = computed_random(head_mouse);
-        //definir a direção da cobra aleatória preenchendo o vetor
-        path_direction.push_back(get_direction());
         path.push_back(random_pos);
         path_valid = true;
     }   
@@ -98,6 +97,23 @@ bool Player::has_path() const{
     return !path.empty();
 }
 
+/**
+ * @brief Hands the last computed path over in compact form.
+ *
+ * Encodes `path` into the player's CompactPath and swaps it with `out`, so
+ * the caller gets the new path and the player keeps the old buffer for the
+ * next call: no cells are copied and, once both buffers have grown, nothing
+ * is allocated.
+ *
+ * @param head_mouse Cell the path starts from (not part of `path`).
+ * @param out Receives the path; its previous contents are discarded.
+ */
+
+void Player::take_route(Point head_mouse, CompactPath& out){
+    route.assign(head_mouse, path);
+    route.swap(out);
+}
+
 
 /**
  * @brief Returns whether the last computed path is valid.
@@ -162,33 +178,40 @@ Point Player::get_next_head_position(Point head_position, Dir next_direction) co
  */
 
 Point Player::computed_random(const Point& head_mouse){
-    std::vector<Dir> possible_directions;
+    Dir possible_directions[4];
+    int count = 0;
  
     // Testa todas as direções
     for (Dir dir : {Dir::N, Dir::S, Dir::L, Dir::O}) {
         Point new_pos = get_next_head_position(head_mouse, dir);
         if (is_valid(new_pos)) {
-            possible_directions.push_back(dir);
+            possible_directions[count++] = dir;
         }
     }
 
-    std::random_device rd;
-    std::mt19937 gen(rd());
-
     // Nenhuma direção livre, adiciona todas possíveis
-    if (possible_directions.empty()) {
-        possible_directions = {Dir::N, Dir::S, Dir::L, Dir::O};
+    if (count == 0) {
+        for (Dir dir : {Dir::N, Dir::S, Dir::L, Dir::O}) {
+            possible_directions[count++] = dir;
+        }
     }
 
-    // Embaralha as direções 
-    std::shuffle(possible_directions.begin(), possible_directions.end(), gen);
-    //Pega a primeira posição do vetor
-    Dir chosen_direction = possible_directions.front();
+    // Sorteia uma das direções com o gerador do jogador (criado uma vez só)
+    std::uniform_int_distribution<int> pick(0, count - 1);
+    Dir chosen_direction = possible_directions[pick(generator)];
     direction_head = chosen_direction;
 
     return get_next_head_position(head_mouse, chosen_direction);
 }
 
+/**
+ * @brief Bytes currently held by the scratch arena of the searches.
+ */
+
+size_t Player::scratch_capacity() const{
+    return arena.capacity();
+}
+
 /**
  * @brief Returns the last direction chosen or used by the snake.
  * 
@@ -204,53 +227,115 @@ void Player::computed_path_A(Point head_mouse) {
     path.clear();
     path_valid = false;
 
-    const int rows = level.rows;
-    const int cols = level.cols;
-
-    Point start = head_mouse;
     Point goal;
-    bool found_goal = false;
+    if (!find_food(goal)) {
+        return;
+    }
+
+    computed_path_A(head_mouse, goal);
+}
+
+/**
+ * @brief Finds the first food pellet on the board, in row order.
+ *
+ * @return False if there is no pellet.
+ */
 
-    // CORREÇÃO DE INDEXAÇÃO: Usando [j][i] para corresponder a [x][y]
-    for (int i = 0; i < rows && !found_goal; ++i) {
-        for (int j = 0; j < cols; ++j) {
+bool Player::find_food(Point& goal) const {
+    for (int i = 0; i < level.rows; ++i) {
+        for (int j = 0; j < level.cols; ++j) {
             if (level.board[i][j] == '*') {
                 goal = {i, j};
-                found_goal = true;
-                break;
+                return true;
             }
         }
     }
+    return false;
+}
+
+/**
+ * @brief A* to the food spread over every hardware thread (see parallel_astar).
+ * 
+ * Gives a path with the same cost as computed_path_A with the Manhattan
+ * heuristic; only worth it on very large boards.
+ * 
+ * @param head_mouse Current position of the mouse's head.
+ */
+
+void Player::computed_path_parallel_A(Point head_mouse) {
+    path.clear();
+    path_valid = false;
+    nodes_expanded = 0;
 
-    if (!found_goal) {
+    Point goal;
+    if (!find_food(goal)) {
         return;
     }
 
-    using State = std::tuple<int, Point>; // Simplificado: Apenas prioridade e ponto
-    std::priority_queue<State, std::vector<State>, std::greater<>> open;
-    
-    std::unordered_map<Point, Point> came_from;
-    std::unordered_map<Point, int> cost_so_far;
+    ParallelAStarStats stats = parallel_astar(level, head_mouse, goal, 0, path);
+    nodes_expanded = stats.nodes_expanded;
+    path_valid = stats.cost >= 0;
+}
 
-    auto heuristic = [](Point a, Point b) {
-        return abs(a.x - b.x) + abs(a.y - b.y);
+/**
+ * @brief A* search from the head of the mouse to a given goal.
+ * 
+ * The heuristic is the Manhattan distance (every cell costs at least 1) or,
+ * when `use_landmarks` is set, the largest of it and the ALT landmark bound,
+ * which accounts for walls and '@'/'%' terrain. The number of nodes taken
+ * from the open list is stored in `nodes_expanded`.
+ * 
+ * @param head_mouse Start of the search (not included in `path`).
+ * @param goal Target cell.
+ */
+
+void Player::computed_path_A(Point head_mouse, Point goal) {
+    path.clear();
+    path_valid = false;
+    nodes_expanded = 0;
+
+    Point start = head_mouse;
+
+    arena.reset();
+
+    const int cols = level.cols;
+    const int cells = level.rows * cols;
+
+    // Estado: prioridade e índice da célula (x * cols + y, mesma ordem de Point)
+    using State = std::pair<int, int>;
+    std::priority_queue<State, std::pmr::vector<State>, std::greater<>> open{std::greater<>(), std::pmr::vector<State>(&arena)};
+
+    std::pmr::vector<int> came_from(cells, -1, &arena);
+    std::pmr::vector<int> cost_so_far(cells, -1, &arena);
+
+    const Landmarks* landmarks = use_landmarks ? &tables->landmarks() : nullptr;
+    auto heuristic = [landmarks](Point a, Point b) {
+        int manhattan = abs(a.x - b.x) + abs(a.y - b.y);
+        if (!landmarks) {
+            return manhattan;
+        }
+        return std::max(manhattan, landmarks->lower_bound(a, b));
     };
 
-    open.emplace(heuristic(start, goal), start);
-    came_from[start] = start;
-    cost_so_far[start] = 0;
+    const int start_idx = start.x * cols + start.y;
+    const int goal_idx = goal.x * cols + goal.y;
+    open.emplace(heuristic(start, goal), start_idx);
+    came_from[start_idx] = start_idx;
+    cost_so_far[start_idx] = 0;
 
-    std::vector<Point> moves = { {-1, 0}, {1, 0}, {0, -1}, {0, 1} };
+    static const Point moves[] = { {-1, 0}, {1, 0}, {0, -1}, {0, 1} };
 
     while (!open.empty()) {
-        auto [priority, current] = open.top();
+        int current_idx = open.top().second;
         open.pop();
+        ++nodes_expanded;
 
-        if (current == goal) {
+        if (current_idx == goal_idx) {
             path_valid = true;
             break;
         }
 
+        Point current{current_idx / cols, current_idx % cols};
         for (auto move : moves) {
             Point next = {current.x + move.x, current.y + move.y};
 
@@ -258,39 +343,231 @@ void Player::computed_path_A(Point head_mouse) {
                 continue;
             }
 
+            int next_idx = next.x * cols + next.y;
             int terrain_cost = get_terrain_cost(next);
-            int new_cost = cost_so_far[current] + terrain_cost;
+            int new_cost = cost_so_far[current_idx] + terrain_cost;
 
-            if (cost_so_far.find(next) == cost_so_far.end() || new_cost < cost_so_far[next]) {
-                cost_so_far[next] = new_cost;
+            if (cost_so_far[next_idx] == -1 || new_cost < cost_so_far[next_idx]) {
+                cost_so_far[next_idx] = new_cost;
                 int new_priority = new_cost + heuristic(next, goal);
-                open.emplace(new_priority, next);
-                came_from[next] = current;
+                open.emplace(new_priority, next_idx);
+                came_from[next_idx] = current_idx;
             }
         }
     }
     
     if (path_valid) {
-        Point current = goal;
-        while (current != start) {
-            path.push_back(current);
-            current = came_from.at(current);
+        for (int current = goal_idx; current != start_idx; current = came_from[current]) {
+            path.push_back({current / cols, current % cols});
         }
-        path.push_back(start);
         std::reverse(path.begin(), path.end());
     }
+    TRACE_COUNTER("nodes expanded", nodes_expanded);
 }
 
 int Player::get_terrain_cost(Point p) {
     // Make sure the point is valid before checking the board
-    if (p.y < 0 || p.y >= level.rows || p.x < 0 || p.x >= level.cols) {
+    if (p.x < 0 || p.x >= level.rows || p.y < 0 || p.y >= level.cols) {
         return 9999; 
     }
 
-    char tile = level.board[p.y][p.x]; // Standard [row][col] access
-    switch (tile) {
-        case '@': return 10; // High difficulty
-        case '%': return 5;  // Medium difficulty
-        default:  return 1;  // Normal ground
+    return level.terrain_cost(level.board[p.x][p.y]); // Standard [row][col] access
+}
+
+/**
+ * @brief Computes the path to the food over the corridor graph of the level.
+ * 
+ * The graph is built on the first call for a level (see LevelTables); here only
+ * the food is located and the graph search is expanded into `path` (without
+ * the head position). If the food cannot be reached, a random valid
+ * direction is chosen, as in the backtracking search.
+ * 
+ * @param head_mouse Current position of the mouse's head.
+ */
+
+void Player::computed_path_corridor(Point head_mouse){
+    path.clear();
+    path_valid = false;
+
+    Point goal = level.food_mouse;
+    const CorridorGraph& corridors = tables->corridors();
+    if(corridors.is_passable(goal) && level.board[goal.x][goal.y] == '*' && corridors.find_path(head_mouse, goal, path, corridor_search)){
+        path_valid = !path.empty();
     }
-}
\ No newline at end of file
+
+    if(not path_valid){
+        Point random_pos = computed_random(head_mouse);
+        path.push_back(random_pos);
+        path_valid = true;
+    }
+}
+
+/**
+ * @brief Computes one path that collects every food pellet on the board.
+ * 
+ * Builds the pairwise cost matrix between the head and all pellets (one
+ * search per pellet, in parallel), orders the pellets with nearest
+ * neighbour followed by 2-opt and expands the tour into `path` (without the
+ * head position). If no pellet can be reached, a random valid direction is
+ * chosen, as in the backtracking search.
+ * 
+ * @param head_mouse Current position of the mouse's head.
+ */
+
+void Player::computed_path_tour(Point head_mouse){
+    path.clear();
+    path_valid = false;
+
+    std::vector<Point> sites{head_mouse};
+    for(int i=0;i<level.rows;++i){
+        for(int j=0;j<level.cols;++j){
+            if(level.board[i][j] == '*'){
+                sites.push_back({i, j});
+            }
+        }
+    }
+
+    if(sites.size() > 1){
+        DistanceMatrix matrix = compute_distance_matrix(level, sites);
+        std::vector<int> order = nearest_neighbour_tour(matrix);
+        improve_tour_2opt(matrix, order);
+        expand_tour(matrix, order, path);
+        path_valid = !path.empty();
+    }
+
+    if(not path_valid){
+        Point random_pos = computed_random(head_mouse);
+        path.push_back(random_pos);
+        path_valid = true;
+    }
+}
+
+/**
+ * @brief Chooses the next cell with Monte Carlo rollouts.
+ * 
+ * Takes a copy-on-write snapshot of the level (pellets, head, score and
+ * lives) and lets the rollout engine score every valid move with random
+ * games played from it. `path` gets only the next cell, so the simulation
+ * asks again on the next tick.
+ * 
+ * @param head_mouse Current position of the mouse's head.
+ */
+
+void Player::computed_path_montecarlo(Point head_mouse){
+    path.clear();
+
+    if(!rollouts){
+        rollouts = std::make_unique<RolloutEngine>();
+    }
+
+    LevelSnapshot root = LevelSnapshot::capture(tables->static_board(), level, head_mouse, score, lives);
+    Dir chosen_direction = rollouts->best_move(root, ROLLOUTS_PER_MOVE, level.rows + level.cols);
+
+    direction_head = chosen_direction;
+    path.push_back(get_next_head_position(head_mouse, chosen_direction));
+    path_valid = true;
+}
+
+/**
+ * @brief Rollout engine of the Monte Carlo player, or null if it never planned.
+ */
+
+const RolloutEngine* Player::get_rollout_engine() const{
+    return rollouts.get();
+}
+
+/**
+ * @brief Starts or resumes the anytime (ARA*) search to the food.
+ *
+ * A new search starts when the pellet moved; otherwise the one in progress
+ * goes on from where the last tick left it. Runs for at most
+ * `plan_budget_us` and puts in `path` the best path from the head found so
+ * far, which may be empty if the first iteration has not finished yet.
+ *
+ * @param head_mouse Current position of the mouse's head.
+ */
+
+void Player::computed_path_ara(Point head_mouse){
+    path.clear();
+    path_valid = false;
+
+    //a posição da comida gerada evita varrer o tabuleiro a cada tick
+    Point goal = level.food_mouse;
+    if(!is_open_cell(level, goal.x, goal.y) || level.board[goal.x][goal.y] != '*'){
+        if(!find_food(goal)){
+            return;
+        }
+    }
+
+    if(!anytime){
+        anytime = std::make_unique<AnytimeSearch>();
+    }
+    if(!anytime->has_goal(level, goal)){
+        anytime->reset(level, goal, head_mouse);
+    }else if(!anytime->reached(head_mouse)){
+        anytime->retarget(head_mouse); //a cabeça voltou ao início
+    }
+
+    anytime->run(head_mouse, std::chrono::microseconds(plan_budget_us));
+    path_valid = anytime->path_from(head_mouse, path);
+    nodes_expanded = anytime->nodes_expanded();
+}
+
+/**
+ * @brief Spends one more tick of budget improving the current ARA* path.
+ *
+ * @param head_mouse Current position of the mouse's head, on the last path.
+ * @return True if `path` now holds a better path from the head.
+ */
+
+bool Player::improve_path_ara(Point head_mouse){
+    if(!anytime || anytime->is_optimal()){
+        return false;
+    }
+    if(!anytime->run(head_mouse, std::chrono::microseconds(plan_budget_us))){
+        return false;
+    }
+    nodes_expanded = anytime->nodes_expanded();
+    path_valid = anytime->path_from(head_mouse, path);
+    return path_valid;
+}
+
+/**
+ * @brief ARA* search of the anytime player, or null if it never planned.
+ */
+
+const AnytimeSearch* Player::get_anytime_search() const{
+    return anytime.get();
+}
+
+/**
+ * @brief Least-cost path to the food with IDA*, in memory that grows with
+ * the path depth instead of the board (see IdaSearch).
+ */
+
+void Player::computed_path_ida(Point head_mouse){
+    path.clear();
+    path_valid = false;
+
+    Point goal = level.food_mouse;
+    if(!is_open_cell(level, goal.x, goal.y) || level.board[goal.x][goal.y] != '*'){
+        if(!find_food(goal)){
+            return;
+        }
+    }
+
+    if(!ida){
+        ida = std::make_unique<IdaSearch>(ida_table_size);
+    }
+    path_valid = ida->search(level, head_mouse, goal, path);
+    nodes_expanded = ida->nodes_expanded();
+    TRACE_COUNTER("nodes expanded", nodes_expanded);
+}
+
+/**
+ * @brief IDA* search of the player, or null if it never planned.
+ */
+
+const IdaSearch* Player::get_ida_search() const{
+    return ida.get();
+}
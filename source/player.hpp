@@ -4,6 +4,15 @@
 #include "level.hpp"
 #include "mouse.hpp"
 #include "direction.hpp"
+#include "level_tables.hpp"
+#include "tour.hpp"
+#include "arena.hpp"
+#include "snapshot.hpp"
+#include "montecarlo.hpp"
+#include "parallel_astar.hpp"
+#include "compact_path.hpp"
+#include "anytime_search.hpp"
+#include "ida_search.hpp"
 
 #include <memory>
 #include <vector>
@@ -20,45 +29,88 @@
 
 struct PathUnit{
     Point current_pos;
-    std::vector<Dir> path;//cmainho de direções
+    int parent; //índice do nó anterior na busca (-1 na cabeça)
+    Dir direction; //direção usada para chegar aqui
 };
 
 
 class Player{
     public:
-        Player(const Level& lvl) : level(lvl){}
+        //sem `shared`, as tabelas são só deste Player (e construídas no primeiro uso)
+        Player(const Level& lvl, std::shared_ptr<LevelTables> shared = nullptr)
+            : level(lvl), tables(shared ? std::move(shared) : std::make_shared<LevelTables>(lvl)) {}
         std::unique_ptr<Mouse> mouse;
         
         Mouse m_mouse;
         size_t score = 0;
-        size_t lives; 
+        size_t lives = 0;
 
-        std::vector<Point> path;
+        std::vector<Point> path; //saída dos planejadores, reaproveitada entre buscas
+        void take_route(Point head_mouse, CompactPath& out);
         void computed_path_bt(Point head_mouse);
         void computed_path_A(Point head_mouse);
+        void computed_path_A(Point head_mouse, Point goal);
+        void computed_path_parallel_A(Point head_mouse);
+        void computed_path_corridor(Point head_mouse);
+        void computed_path_tour(Point head_mouse);
+        void computed_path_montecarlo(Point head_mouse);
+        void computed_path_ara(Point head_mouse);
+        bool improve_path_ara(Point head_mouse);
+        void computed_path_ida(Point head_mouse);
         bool has_path() const;
         bool get_valid_path() const;
         Dir get_direction();
         Point computed_random(const Point& head_mouse);
-        
-        std::vector<Dir> path_direction;
+
         Point get_next_head_position(Point head_position, Dir next_direction) const;
         const std::vector<Point>& get_body() const;
         void increase_mouse_size();
         size_t get_mouse_size() const;
 
-        std::vector<Point> get_path() const{
+        const std::vector<Point>& get_path() const{
             return path;
         }
 
         int get_terrain_cost(Point p);
+
+        //ALT: limites inferiores por landmarks no A*
+        static const int LANDMARK_COUNT = LevelTables::LANDMARK_COUNT;
+        bool use_landmarks = true;
+        size_t nodes_expanded = 0;
+        size_t scratch_capacity() const;
+
+        //Monte Carlo: simulações aleatórias por movimento candidato
+        static const int ROLLOUTS_PER_MOVE = 64;
+        const RolloutEngine* get_rollout_engine() const;
+
+        //ARA*: tempo de busca por tick, em microssegundos (0 = sem limite)
+        long plan_budget_us = 0;
+        const AnytimeSearch* get_anytime_search() const;
+
+        //IDA*: entradas da tabela de transposição (0 = sem tabela)
+        size_t ida_table_size = IdaSearch::DEFAULT_TABLE_SIZE;
+        const IdaSearch* get_ida_search() const;
+
+        const LevelTables& get_tables() const { return *tables; }
         
     private:
         const Level& level;
+        std::shared_ptr<LevelTables> tables;
+        CorridorGraph::Search corridor_search;
         Dir direction_head{Dir::N};
         bool path_valid = true;
         bool is_valid(const Point& p) const;
-        
+        bool find_food(Point& goal) const;
+
+        //memória de trabalho das buscas, reiniciada no começo de cada uma
+        ScratchArena arena;
+        std::mt19937 generator{std::random_device{}()};
+
+        std::unique_ptr<RolloutEngine> rollouts; //criado no primeiro uso
+        CompactPath route; //buffer trocado com o da simulação em take_route
+        std::unique_ptr<AnytimeSearch> anytime; //busca ARA* em andamento, criada no primeiro uso
+        std::unique_ptr<IdaSearch> ida; //criada no primeiro uso, com ida_table_size entradas
+
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,49 @@
+#include "search.hpp"
+#include "level.hpp"
+
+#include <functional>
+#include <queue>
+
+bool is_open_cell(const Level& level, int x, int y){
+    return x >= 0 && y >= 0 && x < level.rows && y < level.cols
+        && y < (int)level.board[x].size() && level.board[x][y] != '#';
+}
+
+void dijkstra(const Level& level, Point source, std::vector<int>& dist, std::vector<int>* parent, bool reverse){
+    const int cols = level.cols;
+    dist.assign(level.rows * cols, UNREACHABLE);
+    if(parent){
+        parent->assign(level.rows * cols, -1);
+    }
+
+    using State = std::pair<int, int>;
+    std::priority_queue<State, std::vector<State>, std::greater<>> open;
+
+    dist[source.x * cols + source.y] = 0;
+    open.emplace(0, source.x * cols + source.y);
+
+    while(!open.empty()){
+        auto [d, idx] = open.top();
+        open.pop();
+        if(d > dist[idx]) continue;
+
+        int x = idx / cols;
+        int y = idx % cols;
+        //ida: entrar no vizinho custa o terreno dele; volta: sair dele para cá custa o terreno daqui
+        int back_cost = level.terrain_cost(level.board[x][y]);
+        for(const Point& move : MOVES){
+            int nx = x + move.x;
+            int ny = y + move.y;
+            if(!is_open_cell(level, nx, ny)) continue;
+            int step = reverse ? back_cost : level.terrain_cost(level.board[nx][ny]);
+            int next = nx * cols + ny;
+            if(d + step < dist[next]){
+                dist[next] = d + step;
+                if(parent){
+                    (*parent)[next] = idx;
+                }
+                open.emplace(dist[next], next);
+            }
+        }
+    }
+}
@@ -0,0 +1,38 @@
+#ifndef SEARCH_HPP
+#define SEARCH_HPP
+
+#include <climits>
+#include <vector>
+
+#include "direction.hpp"
+
+class Level;
+
+const int UNREACHABLE = INT_MAX;
+
+/**
+ * @brief Checks whether a cell is inside the board and is not a wall.
+ *
+ * Rows shorter than the level width are treated as walls past their end.
+ */
+
+bool is_open_cell(const Level& level, int x, int y);
+
+/**
+ * @brief Terrain-weighted Dijkstra over the whole board.
+ *
+ * Moving into a cell costs Level::terrain_cost of that cell. Cells are
+ * indexed as x * cols + y.
+ *
+ * @param level Level to search.
+ * @param source Cell where the search starts.
+ * @param dist Receives rows * cols distances (UNREACHABLE when not reached).
+ * If `reverse` is set, dist[v] is the cost from v to source instead.
+ * @param parent If not null, receives the previous cell index on the
+ * shortest path from source (-1 for the source and unreached cells).
+ * @param reverse Computes distances towards the source.
+ */
+
+void dijkstra(const Level& level, Point source, std::vector<int>& dist, std::vector<int>* parent = nullptr, bool reverse = false);
+
+#endif
@@ -6,11 +6,17 @@
 #include <vector>
 #include <unordered_map>
 
+#include <unistd.h>
+
 #include "simulation.hpp"
 #include "level.hpp"
 #include "output.hpp"
 #include "mouse.hpp"
 #include "player.hpp"
+#include "planner.hpp"
+#include "level_reader.hpp"
+#include "embedded_levels.hpp"
+#include "trace.hpp"
 
 /**
  * @brief Returns the single instance of the simulation using the Singleton pattern.
@@ -71,6 +77,9 @@ void MouzeSimulation::parse_config(const std::string& filename){
     if (config_game.count("lives"))   lives = std::stoi(config_game["lives"]);
     if (config_game.count("food"))    food = std::stoi(config_game["food"]);
     if (config_game.count("playertype"))  player_type = config_game["playertype"];
+    if (config_game.count("budget"))  plan_budget_us = std::stol(config_game["budget"]);
+    if (config_game.count("idatable")) ida_table_size = std::stoul(config_game["idatable"]);
+    if (config_game.count("cache"))   cache_capacity = std::stoul(config_game["cache"]);
 
 }
 
@@ -104,7 +113,7 @@ void MouzeSimulation::initialize(int argc, char* argv[]){
     }
     else if(arg=="--playertype"){
         if (i + 1 >= (size_t)argc) {
-            help_screen("You must put a random, backtracking or A* playertype!"); 
+            help_screen("You must put a playertype: " + planner_names() + "."); 
             exit(1);
         }
       
@@ -122,6 +131,103 @@ void MouzeSimulation::initialize(int argc, char* argv[]){
         lives=std::stoi(next_arg);
         ++i;
     }
+    else if(arg=="--budget"){
+        if (i + 1 >= (size_t)argc) {
+            help_screen("After --budget there must be integer value.");
+            exit(1);
+        }
+
+        std::string next_arg = argv[i + 1];
+        plan_budget_us=std::stol(next_arg);
+        ++i;
+    }
+    else if(arg=="--ida-table"){
+        if (i + 1 >= (size_t)argc) {
+            help_screen("After --ida-table there must be integer value.");
+            exit(1);
+        }
+
+        std::string next_arg = argv[i + 1];
+        ida_table_size=std::stoul(next_arg);
+        ++i;
+    }
+    else if(arg=="--cache"){
+        if (i + 1 >= (size_t)argc) {
+            help_screen("After --cache there must be integer value.");
+            exit(1);
+        }
+
+        std::string next_arg = argv[i + 1];
+        cache_capacity=std::stoul(next_arg);
+        ++i;
+    }
+    else if(arg=="--allfood"){
+        all_food=true;
+    }
+    else if(arg=="--stream"){
+        stream_levels=true;
+    }
+    else if(arg=="--trace"){
+        if (i + 1 >= (size_t)argc) {
+            help_screen("After --trace there must be a file name.");
+            exit(1);
+        }
+
+        trace_filename=argv[i + 1];
+        ++i;
+    }
+    else if(arg=="--serve"){
+        if (i + 1 >= (size_t)argc) {
+            help_screen("After --serve there must be a socket path or '-'.");
+            exit(1);
+        }
+
+        serve_target=argv[i + 1];
+        ++i;
+    }
+    else if(arg=="--stats"){
+        live_stats=true;
+    }
+    else if(arg=="--build-db"){
+        build_database=true;
+    }
+    else if(arg=="--games"){
+        if (i + 1 >= (size_t)argc) {
+            help_screen("After --games there must be integer value.");
+            exit(1);
+        }
+
+        game_count=std::stoul(argv[i + 1]);
+        ++i;
+    }
+    else if(arg=="--layout"){
+        std::string name = i + 1 < (size_t)argc ? argv[i + 1] : "";
+        if (name != "row" && name != "morton") {
+            help_screen("After --layout there must be 'row' or 'morton'.");
+            exit(1);
+        }
+
+        cell_layout = name == "morton" ? CellLayout::MORTON : CellLayout::ROW_MAJOR;
+        ++i;
+    }
+    else if(arg=="--baseline"){
+        if (i + 1 >= (size_t)argc) {
+            help_screen("After --baseline there must be a file name.");
+            exit(1);
+        }
+
+        baseline_filename=argv[i + 1];
+        ++i;
+    }
+    else if(arg=="--bench"){
+        if (i + 1 >= (size_t)argc) {
+            help_screen("After --bench there must be a benchmark name.");
+            exit(1);
+        }
+
+        bench_section=argv[i + 1];
+        ++i;
+    }
     else if(ends_with(arg,".dat")){
         level_filename=arg;
     }
@@ -141,21 +247,131 @@ void MouzeSimulation::initialize(int argc, char* argv[]){
    }
 
     
-    if(level_filename.empty()){
+    if(!bench_section.empty()){
+        stream_levels = false; //os benchmarks percorrem todos os níveis
+        if(!level_filename.empty()){
+            open_process_file();
+        }
+        exit(run_benchmarks() ? 0 : 1);
+    }
+
+    if(game_count > 0 && stream_levels){
+        //cada jogo percorre os níveis por conta própria: o arquivo todo fica na memória
+        std::cout << "Warning: --stream is ignored with --games.\n";
+        stream_levels = false;
+    }
+
+    if(serve_target == "-"){
+        std::cout.rdbuf(std::cerr.rdbuf()); //a saída padrão fica só com as respostas
+    }
+
+    if(level_filename.empty() && has_embedded_levels()){
+        //níveis compilados no binário: sem leitura de arquivo
+        levels = embedded_levels();
+        stream_levels = false;
+        std::cout << "Info: " << levels.size() << " embedded levels loaded.\n";
+    }else if(level_filename.empty()){
         help_screen("Input file not specified. You must provide an initialization file.");
         exit(1);
     }else{
         open_process_file();
     }
 
+    if(build_database){
+        build_path_databases();
+        exit(0);
+    }
+
+    if(!serve_target.empty()){
+        run_service();
+        exit(0);
+    }
+
     if (!config_filename.empty()) {
         parse_config(config_filename);
     } else {
         std::cout << "File '.ini' not provided. Using default settings.\n";
     }
+
+    resolve_player_type();
+
+    if(cache_capacity > 0){
+        path_cache = std::make_unique<PathCache>(cache_capacity);
+        //com todas as comidas no tabuleiro o objetivo não é uma célula só
+        walk.cache = all_food ? nullptr : path_cache.get();
+    }
+
+    if(live_stats){
+        if(stats.create(LiveStats::default_name())){
+            std::cout << "Info: Live statistics in shared memory " << stats.get_name() << " (watch with mouze-top).\n";
+            stats_sample.pid = getpid();
+            LiveStats::copy_text(stats_sample.planner, player_type.c_str());
+        }else{
+            std::cout << "Warning: Could not create the live statistics segment.\n";
+        }
+    }
+
+    if(game_count > 0){
+        run_games();
+        exit(0);
+    }
+}
+
+/**
+ * @brief Binds the planner named by `player_type` to the THINKING state.
+ *
+ * The lookup in the planner registry happens once, here; afterwards each
+ * tick calls the `think_with` instantiation of the chosen planner directly.
+ */
+
+void MouzeSimulation::resolve_player_type(){
+    bool found = resolve_planner(player_type, [this](auto tag){
+        using Planner = typename decltype(tag)::type;
+        think = &MouzeSimulation::think_with<Planner>;
+        //o jogador de rota planeja todas as comidas de uma vez
+        all_food = all_food || Planner::all_food;
+    });
+
+    if(!found){
+        help_screen("Unknown playertype '" + player_type + "'. Use one of: " + planner_names() + ".");
+        exit(1);
+    }
+}
+
+/**
+ * @brief One THINKING step with a given planner.
+ *
+ * Moves the head one cell along the walked path (see walk_route) and flags
+ * what was found there.
+ */
+
+template <typename Planner>
+void MouzeSimulation::think_with(){
+    switch(walk_route<Planner>(*player, active_level(), head_mouse, walk)){
+        case StepResult::MOVED:
+            has_none = true;
+            break;
+        case StepResult::ATE:
+            has_food = true;
+            break;
+        case StepResult::CRASHED:
+            has_wall = true;
+            dead = true;
+            break;
+        case StepResult::WAITING:
+            waiting = true;
+            break;
+        case StepResult::STUCK:
+            break;
+    }
 }
 
 void MouzeSimulation::process_events(){
+    //um trecho por tick, com o nome do estado
+    TRACE_SCOPE(state_name(game_state));
+
+    sync_output();
+
     if(game_state==START){
         std::cout<<"\n----WELCOME TO THE MOUZE GAME!----\n";
     }
@@ -163,132 +379,60 @@ void MouzeSimulation::process_events(){
         //pressionar enter
         std::string line;
         std::getline(std::cin, line);
-        player = std::make_unique<Player>(levels[current_level_idx]);
+        player = std::make_unique<Player>(active_level());
         player->lives = lives;
+        player->plan_budget_us = plan_budget_us;
+        player->ida_table_size = ida_table_size;
     }
     else if(game_state == LOAD_LEVEL){
     
-        if(current_level_idx < levels.size()){
+        if(!levels.empty()){
 
-            Level& current_level = levels[current_level_idx]; //pegando o nível 
-
-            if(initial_level){
-                current_level.find_start_position();
-            }
+            Level& current_level = active_level(); //pegando o nível (já pré-processado na leitura)
 
             render_board(current_level);
             // Gera a comida 
-            current_level.generate_food();
+            if(!all_food){
+                current_level.generate_food(generator);
+            }else if(!food_placed){
+                current_level.generate_all_food(food, generator);
+                food_placed = true;
+            }
         }
 
-        const Level& current_level = levels[current_level_idx];
+        const Level& current_level = active_level();
         
         if(initial_level){
-            levels[current_level_idx].current_mouse = levels[current_level_idx].start_mouse;
-            head_mouse = levels[current_level_idx].start_mouse;
-            //reiniciar o indice do caminho p rodar novo caminho 
-            idx_path = 0;
-            
+            active_level().current_mouse = active_level().start_mouse;
+            head_mouse = active_level().start_mouse;
             //imprimir level inicial
-            levels[current_level_idx].reset_level(initial_level);
+            active_level().reset_level(initial_level);
             std::this_thread::sleep_for(std::chrono::milliseconds(fps));
             render_board(current_level); //labirinto
             initial_level = false;
-            search_food = true;
+            walk.replan = true;
         }
 
         
         //imprimir antes de mudar de lugar e depois de identificar onde é o ponto de spaw
-        levels[current_level_idx].fill_data(head_mouse, dead);
+        active_level().fill_data(head_mouse, dead);
         std::this_thread::sleep_for(std::chrono::milliseconds(fps));
         render_board(current_level); //labirinto
     }else if(game_state == GameState::THINKING){
         //limpar os dados p ele n ficar preso
         clear_actions();
 
-        const Level& current_level = levels[current_level_idx];
-
-        if(player_type=="backtracking" ){
-            if(search_food || idx_path >= path_execute.size()){
-                player->computed_path_bt(head_mouse);
-                path_execute.clear();
-                path_execute = player->path;
-                idx_path = 0;
-                search_food = false;
-            }
-               
-            if(idx_path < path_execute.size()){
-                Point next_head_snake = path_execute[idx_path];
-                ++idx_path;
-                
-                char next_cell = level.get_cell(current_level, next_head_snake);
-
-                if (level.is_empty_cell(next_cell)) {
-                    has_none = true;
-                    head_mouse = next_head_snake;
-                } else if (level.is_food(next_cell)) {
-                    has_food = true;
-                    head_mouse = next_head_snake;
-                    levels[current_level_idx].current_mouse = head_mouse;
-                    levels[current_level_idx].update_board_after_food(); // para limpar a comida
-                    idx_path = 0;
-                    search_food = true;
-                } else {
-                    has_wall = true;
-                    dead = true;
-                }
-            }
-        }else if(player_type == "A*"){
-            if(search_food || idx_path >= path_execute.size()){
-                player->computed_path_A(head_mouse);
-                path_execute.clear();
-                path_execute = player->path;
-                idx_path = 0;
-                search_food = false;
-            }
-              // for(auto p : path_execute){
-              // std::cout << "x: " << p.x <<" , y: "<<p.y<<"\n";
-               //}
-               
-            if(idx_path < path_execute.size()){
-                ++idx_path;
-                Point next_head_snake = path_execute[idx_path];
-                //++idx_path;
-                
-                char next_cell = level.get_cell(current_level, next_head_snake);
-                // std::cout<<"x: "<< next_cell <<"\n";
-
-                if (level.is_empty_cell(next_cell)) {
-                    has_none = true;
-                    head_mouse = next_head_snake;
-                } else if (level.is_food(next_cell)) {
-                    has_food = true;
-                    head_mouse = next_head_snake;
-                    levels[current_level_idx].current_mouse = head_mouse;
-                    levels[current_level_idx].update_board_after_food(); // para limpar a comida
-                    idx_path = 0;
-                    search_food = true;
-                } else {
-                    has_wall = true;
-                    dead = true;
-                }
-            }
-        }else{     
-            Point next_head_snake = player->computed_random(head_mouse);
-
-            char next_cell = level.get_cell(current_level, next_head_snake);
-
-            if(level.is_empty_cell(next_cell)){
-                has_none = true;
-                head_mouse = next_head_snake;
-            }else if(level.is_food(next_cell)){
-                has_food = true;
-                head_mouse = next_head_snake;
-            }else{
-                has_wall = true;
-                dead = true;
-            }
+        //planejador escolhido uma única vez em initialize()
+        if(stats.is_open()){
+            auto begin = std::chrono::steady_clock::now();
+            (this->*think)();
+            stats_sample.think_ns_last = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin).count();
+            stats_sample.think_ns_total += stats_sample.think_ns_last;
+            ++stats_sample.think_calls;
+        }else{
+            (this->*think)();
         }
+
         //pontuação por comer ou por andar sem bater
         if(has_food){
             player->score += 100;
@@ -297,10 +441,10 @@ void MouzeSimulation::process_events(){
             player->score += 5;
         }
     }else if(game_state == GameState::RUNNING){
-        levels[current_level_idx].reset_level(initial_level);
-        levels[current_level_idx].fill_data(head_mouse, dead);
+        active_level().reset_level(initial_level);
+        active_level().fill_data(head_mouse, dead);
         std::this_thread::sleep_for(std::chrono::milliseconds(fps));
-        render_board(levels[current_level_idx]);
+        render_board(active_level());
         dead = false;
     }else if(game_state == GameState::EATING){
         player->increase_mouse_size();
@@ -310,8 +454,10 @@ void MouzeSimulation::process_events(){
         std::string line;
         std::getline(std::cin, line);
         --player->lives;
-        levels[current_level_idx].current_mouse = levels[current_level_idx].start_mouse;
-        reset_food();
+        active_level().current_mouse = active_level().start_mouse;
+        if(!all_food){
+            reset_food();
+        }
         //quando morre o corpo vai pro inicio junto da cabeça dela
     }else if(game_state == GameState::LEVEL_UP){
         player->score += 250;
@@ -319,14 +465,20 @@ void MouzeSimulation::process_events(){
         int aux_lives = player->lives;
 
         initial_level = true; //cabeça ir pro novo ponto de spaw
+        food_placed = false;
 
-        ++current_level_idx;
-        //mudar o nível do player e restaurar informações dele
-        player = std::make_unique<Player>(levels[current_level_idx]);
-        player->score = aux_score;
-        player->lives = aux_lives;
+        if(path_cache){
+            path_cache->invalidate(current_level_idx); //o nível deixado não volta
+        }
+        if(advance_level()){
+            walk.level = current_level_idx;
+            //mudar o nível do player e restaurar informações dele
+            player = std::make_unique<Player>(active_level());
+            player->score = aux_score;
+            player->lives = aux_lives;
+            player->plan_budget_us = plan_budget_us;
+            player->ida_table_size = ida_table_size;
 
-        if(current_level_idx<levels.size()){
             std::cout<<"\n Press <ENTER> for the next level.\n";
             //pressionar enter
             std::string line;
@@ -343,6 +495,8 @@ void MouzeSimulation::process_events(){
 }
 
 void MouzeSimulation::update(){
+    publish_stats();
+
     if(game_state==GameState::START){
         game_state=GameState::WELCOME;
     }else if (game_state==GameState::WELCOME){
@@ -356,7 +510,7 @@ void MouzeSimulation::update(){
             game_state = GameState::EATING;
         }else if(has_wall){
             game_state= GameState::CRASHED;
-        }else if(has_none){
+        }else if(has_none || waiting){
             game_state=GameState::THINKING;
         }
        
@@ -388,6 +542,7 @@ void MouzeSimulation::update(){
 }
 
 void MouzeSimulation::render(){
+    sync_output();
     if(game_state==WELCOME){
         std::cout << "\n Press <ENTER> for continue.\n";
     }
@@ -412,10 +567,31 @@ void MouzeSimulation::render(){
     }
     else if(game_state==END){
         std::cout<<"\n--END GAME--\n";
+        if(path_cache){
+            std::cout<<"Path cache: "<<path_cache->hits()<<" hits, "<<path_cache->misses()<<" misses ("
+                     <<(int)(path_cache->hit_rate() * 100 + 0.5)<<"%), "<<path_cache->size()<<" paths, "
+                     <<(path_cache->memory_bytes() + 512) / 1024<<" KiB\n";
+        }
+        if(!trace_filename.empty() && !export_chrome_trace(trace_filename)){
+            std::cout<<"Warning: Trace not written (build with -DMOUZE_TRACE to enable tracing).\n";
+        }
     }
 }
 
 void MouzeSimulation::open_process_file(){
+    if(stream_levels){
+        if(!level_stream.open(level_filename)){
+            std::cout<<"\nError: Could not open this file.\n";
+            exit(1);
+        }
+        levels.resize(1);
+        if(!take_streamed_level()){
+            std::cout << "Error: No valid levels found in the file." << std::endl;
+            exit(1);
+        }
+        return;
+    }
+
     std::ifstream level_file(level_filename);
 
     if(!level_file.is_open()){
@@ -423,67 +599,70 @@ void MouzeSimulation::open_process_file(){
         exit(1);
     }
 
-    while(level_file >> rows >> cols){
-        if(rows <= 0 || cols<=0 || rows>100 || cols > 100 ){
-            std::cout<<"\nINVALID DIMENSIONS!\n";
+    std::vector<LevelRecord> records = read_all_levels(level_file);
+    levels.reserve(records.size());
+    for(LevelRecord& record : records){
+        std::cout << record.messages;
+        if(record.status == ReadStatus::INVALID_DIMENSIONS){
             exit(1);
         }
-
-        // Ignora o resto da linha de dimensões para começar a leitura do tabuleiro
-        level_file.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-
-        Level current_level;
-        current_level.rows = rows;
-        current_level.cols = cols;
-        current_level.board.resize(rows);
-
-        int spawn_point_count = 0; //quantidade de &
-        bool valid_nivel=true;
-
-        for (int i = 0; i < rows; ++i) {
-                std::getline(level_file, current_level.board[i]);
-                // Conta os pontos de spawn na linha 
-                for (char c : current_level.board[i]) {
-                    if (c == '&') {
-                        spawn_point_count++;
-                    }
-
-                    if (!(c == '#' ||c == '@' || c == '%' || c == '&' || c == ' ' || c=='.')) {
-                        std::cout << "Error: Invalid character '" << c << "' found." << std::endl;
-                        std::cout << "Level ignored because it contains symbols that are not allowed." << std::endl;
-                        valid_nivel = false;
-                        break;
-                    }
-                }
-                if(!valid_nivel){
-                    break;
-                }
-               
-            }
-        
-            // Valida o conteúdo do tabuleiro
-            if (spawn_point_count > 1) {
-                std::cout << "Warning: The level "<<rows<< "x" <<cols<<" contains more than one '&'." << std::endl;
-                // Continua para o próximo nível no arquivo, se houver
-                continue;
-            }
-            
-            if(spawn_point_count==0){
-                std::cout<<"Warning: The level "<<rows<<"x"<<cols<<" does not contain a spawn point ('&')."<<std::endl;
-                continue;
-            }
-            
-            //Se tudo estiver correto, adiciona o nível à lista
-            levels.push_back(current_level);
-            std::cout << "Info: Level of " << rows << "x" << cols << " loaded successfully." << std::endl;
+        //Se tudo estiver correto, adiciona o nível à lista
+        if(record.status == ReadStatus::LOADED){
+            levels.push_back(std::move(record.level));
         }
+    }
 
-
-      if(levels.empty()){
+    if(levels.empty()){
         std::cout << "Error: No valid levels found in the file." << std::endl;
         exit(1);
-      }
-}  
+    }
+}
+
+/**
+ * @brief Replaces the level in memory with the next one of the stream.
+ *
+ * Prints the messages of the levels read and ends the program on a fatal
+ * error, like open_process_file.
+ *
+ * @return False when the file has no level left.
+ */
+
+bool MouzeSimulation::take_streamed_level(){
+    LevelRecord record = level_stream.next();
+    std::cout << record.messages;
+    if(record.status == ReadStatus::INVALID_DIMENSIONS){
+        exit(1);
+    }
+    if(record.status != ReadStatus::LOADED){
+        return false;
+    }
+    levels.front() = std::move(record.level); //o nível terminado é liberado aqui
+    return true;
+}
+
+/**
+ * @brief Level being played.
+ *
+ * With --stream only the current level is kept, at the front of `levels`.
+ */
+
+Level& MouzeSimulation::active_level(){
+    return stream_levels ? levels.front() : levels[current_level_idx];
+}
+
+/**
+ * @brief Moves on to the next level of the file.
+ *
+ * @return False if the finished level was the last one.
+ */
+
+bool MouzeSimulation::advance_level(){
+    ++current_level_idx;
+    if(stream_levels){
+        return take_streamed_level();
+    }
+    return current_level_idx < levels.size();
+}
 
 /**
  * @brief Trims whitespace from the beginning and end of a string.
@@ -514,8 +693,8 @@ void MouzeSimulation::trim(std::string& s) {
  */
 
 void MouzeSimulation::reset_food(){
-    Point clear = levels[current_level_idx].food_mouse;
-    levels[current_level_idx].board[clear.x][clear.y] = ' ';
+    Point clear = active_level().food_mouse;
+    active_level().board[clear.x][clear.y] = ' ';
 }
 
 /**
@@ -566,15 +745,61 @@ bool MouzeSimulation::is_over() const{
     return false;
 }
 
+/**
+ * @brief Waits for the render thread before a state that prints text.
+ *
+ * Boards are drawn asynchronously; messages and waits for <ENTER> must only
+ * appear after the last board. The states of a normal tick do not wait.
+ */
+
+void MouzeSimulation::sync_output(){
+    if(game_state != LOAD_LEVEL && game_state != THINKING && game_state != RUNNING && game_state != EATING){
+        frames.drain();
+    }
+}
+
+/**
+ * @brief Name of a game state, as shown in traces.
+ */
+
+const char* MouzeSimulation::state_name(GameState state){
+    static const char* const names[] = {
+        "START", "WELCOME", "LOAD_LEVEL", "THINKING", "RUNNING", "EATING",
+        "CRASHED", "LEVEL_UP", "LOST", "WON", "END"
+    };
+    return names[state];
+}
+
+/**
+ * @brief Publishes the counters of this tick for mouze-top (--stats).
+ */
+
+void MouzeSimulation::publish_stats(){
+    if(!stats.is_open()){
+        return;
+    }
+    ++stats_sample.ticks;
+    if(player){
+        stats_sample.score = player->score;
+        stats_sample.lives = player->lives;
+        stats_sample.eaten = player->get_mouse_size();
+    }
+    stats_sample.level = current_level_idx;
+    stats_sample.food = food;
+    LiveStats::copy_text(stats_sample.state, state_name(game_state));
+    stats.publish(stats_sample);
+}
+
 /**
  * @brief Resets the game's action and event indicators.
  *
  * Clears the flags that indicate if the snake has eaten food, hit a wall,
- * moved to an empty cell, or collided with its own body.
+ * moved to an empty cell, waited for a path, or collided with its own body.
  */
 
 void MouzeSimulation::clear_actions(){
     has_food = false;
     has_wall = false;
     has_none = false;
+    waiting = false;
 }
@@ -8,11 +8,17 @@
 #include <chrono>
 #include <thread>
 #include <memory>
+#include <random>
 
 #include "level.hpp"
 #include "mouse.hpp"
 #include "player.hpp"
 #include "direction.hpp"
+#include "level_reader.hpp"
+#include "frame_renderer.hpp"
+#include "path_query.hpp"
+#include "planner.hpp"
+#include "live_stats.hpp"
 
 class MouzeSimulation
 {
@@ -38,47 +44,85 @@ class MouzeSimulation
     size_t lives;
     size_t food;
     std::string player_type;
+    long plan_budget_us = 2000; //--budget: tempo de busca por tick do ARA*
+    size_t ida_table_size = IdaSearch::DEFAULT_TABLE_SIZE; //--ida-table: entradas da tabela do IDA*
+    size_t cache_capacity = 0; //--cache: caminhos guardados (0 = sem cache)
+    std::unique_ptr<PathCache> path_cache;
     std::string level_filename;
     std::string config_filename;
+    std::string bench_section;
+    std::string baseline_filename; //--baseline: referência do --bench verify
+    std::string serve_target; //--serve: socket ou "-" para entrada/saída padrão
+    CellLayout cell_layout = DEFAULT_CELL_LAYOUT; //--layout: ordem das células no --serve
+    bool build_database = false; //--build-db: grava as tabelas de primeiro passo e sai
+    size_t game_count = 0; //--games: jogos simultâneos numa thread, sem desenhar
+    std::string trace_filename; //--trace: arquivo JSON do Chrome trace
     std::unique_ptr<Player> player;
+    void (MouzeSimulation::*think)() = nullptr; //passo THINKING do planejador escolhido
     bool have_path = false;
-    std::vector<Point> path_execute;
-    size_t idx_path = 1;//0 é onde a cabeça já tá
-    bool search_food = true;
+    RouteWalk walk; //caminho em execução e a próxima célula dele
+    bool all_food = false; //todas as comidas no tabuleiro desde o início
+    bool food_placed = false;
+    std::mt19937 generator{std::random_device{}()}; //posições das comidas
 
     int rows;
     int cols;
     
     std::vector<Level> levels; 
     size_t current_level_idx = 0;
+    bool stream_levels = false; //lê um nível por vez em vez do arquivo todo
+    LevelStream level_stream;
     bool has_level = false;
     bool initial_level = true;
     
     bool has_food = false;
     bool has_wall = false;
     bool has_none=false;
+    bool waiting = false; //sem caminho ainda: fica parado neste tick
     Level level; 
 
     //da cobra
     bool dead = false;
     Point head_mouse;
+
+    FrameRenderer frames; //desenha os tabuleiros em outra thread
+
+    bool live_stats = false; //--stats: publica os contadores em memória compartilhada
+    LiveStats stats;
+    LiveSample stats_sample;
     
    public:
     static MouzeSimulation& instance();
 
     MouzeSimulation();
     void open_process_file();
+    bool take_streamed_level();
+    Level& active_level();
+    bool advance_level();
     bool is_full_food();
     void reset_food();
     bool is_over() const;
+    static const char* state_name(GameState state);
+    void sync_output();
     void trim(std::string& s);
     bool ends_with(const std::string& str, const std::string& suffix);
     void clear_actions();
+    void publish_stats();
 
     //output.cpp 
     void help_screen(std::string_view msg="");
     void render_board(const Level& level_to_draw);
     void run_tests();
+
+    //benchmark.cpp
+    bool run_benchmarks();
+
+    //path_service.cpp
+    void run_service();
+    void build_path_databases();
+
+    //game_engine.cpp
+    void run_games();
     
     //funções principais
     void initialize(int argc, char* argv[]);
@@ -86,6 +130,8 @@ class MouzeSimulation
     void update();
     void render();
     void parse_config(const std::string& filename);
+    void resolve_player_type();
+    template <typename Planner> void think_with();
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,175 @@
+#include "snapshot.hpp"
+#include "level.hpp"
+
+#include <cstdlib>
+
+/**
+ * @brief Builds the part of a level's board that never changes during play.
+ *
+ * Keeps walls and terrain; the spawn point, the mouse and the pellets become
+ * empty cells (pellets are added to each snapshot's overlay).
+ */
+
+SharedBoard LevelSnapshot::static_board(const Level& level){
+    auto board = std::make_shared<std::vector<std::string>>();
+    level.board.copy_to(*board);
+    for(std::string& line : *board){
+        line.resize(level.cols, '#');
+        for(char& cell : line){
+            if(cell != '#' && cell != '@' && cell != '%' && cell != '.'){
+                cell = ' ';
+            }
+        }
+    }
+    return board;
+}
+
+/**
+ * @brief Takes a snapshot of the current game state.
+ *
+ * @param board Static board of the level (see static_board), shared.
+ * @param level Level being played; only its pellets and spawn are read.
+ * @param head Current head position.
+ * @param score Current score.
+ * @param lives Lives left.
+ */
+
+LevelSnapshot LevelSnapshot::capture(const SharedBoard& board, const Level& level, Point head, size_t score, size_t lives){
+    LevelSnapshot snapshot;
+    snapshot.board = board;
+    snapshot.rows = level.rows;
+    snapshot.cols = level.cols;
+    snapshot.head = head;
+    snapshot.start = level.start_mouse;
+    snapshot.score = score;
+    snapshot.lives = lives;
+
+    for(int i=0;i<level.rows;++i){
+        for(int j=0;j<(int)level.board[i].size() && j<level.cols;++j){
+            if(level.board[i][j] == '*'){
+                snapshot.set({i, j}, '*');
+            }
+        }
+    }
+    return snapshot;
+}
+
+char LevelSnapshot::get(Point p) const{
+    if(p.x < 0 || p.y < 0 || p.x >= rows || p.y >= cols){
+        return '#';
+    }
+    int idx = p.x * cols + p.y;
+    for(int k=overlay_size-1;k>=0;--k){
+        if(overlay[k].first == idx){
+            return overlay[k].second;
+        }
+    }
+    return (*board)[p.x][p.y];
+}
+
+/**
+ * @brief Changes one cell of this snapshot only.
+ *
+ * Writes in place when this snapshot already has a board of its own that no
+ * copy shares, otherwise in the overlay; a full overlay makes the snapshot
+ * detach first.
+ */
+
+void LevelSnapshot::set(Point p, char cell){
+    int idx = p.x * cols + p.y;
+    if(detached && board.use_count() == 1){
+        (*board)[p.x][p.y] = cell;
+        return;
+    }
+    for(int k=0;k<overlay_size;++k){
+        if(overlay[k].first == idx){
+            overlay[k].second = cell;
+            return;
+        }
+    }
+    if(overlay_size == OVERLAY_SIZE){
+        detach();
+        (*board)[p.x][p.y] = cell;
+        return;
+    }
+    overlay[overlay_size++] = {idx, cell};
+}
+
+/**
+ * @brief Gives this snapshot its own copy of the board, with the overlay applied.
+ */
+
+void LevelSnapshot::detach(){
+    board = std::make_shared<std::vector<std::string>>(*board);
+    detached = true;
+    for(int k=0;k<overlay_size;++k){
+        (*board)[overlay[k].first / cols][overlay[k].first % cols] = overlay[k].second;
+    }
+    overlay_size = 0;
+}
+
+/**
+ * @brief Moves the head one cell, with the scoring of the simulation.
+ *
+ * Empty and terrain cells give 5 points, a pellet gives 100 and is removed;
+ * anything else is a crash, which costs a life and sends the head back to
+ * the spawn point.
+ *
+ * @return False if the move crashed.
+ */
+
+bool LevelSnapshot::step(Dir direction){
+    Point next{head.x + MOVES[direction].x, head.y + MOVES[direction].y};
+    char cell = get(next);
+
+    if(cell == ' ' || cell == '@' || cell == '%'){
+        head = next;
+        score += 5;
+        return true;
+    }
+    if(cell == '*'){
+        head = next;
+        score += 100;
+        ++food_eaten;
+        set(next, ' ');
+        return true;
+    }
+
+    if(lives > 0) --lives;
+    head = start;
+    return false;
+}
+
+/**
+ * @brief Finds the pellet closest to the head (Manhattan distance).
+ *
+ * Pellets only live in the overlay or, after a detach, in the own board.
+ *
+ * @return False if there is no pellet left.
+ */
+
+bool LevelSnapshot::nearest_food(Point& food) const{
+    int best = -1;
+    auto consider = [&](Point p){
+        int d = std::abs(p.x - head.x) + std::abs(p.y - head.y);
+        if(best == -1 || d < best){
+            best = d;
+            food = p;
+        }
+    };
+
+    //depois de um detach as comidas também podem estar no tabuleiro
+    if(detached){
+        for(int i=0;i<rows;++i){
+            for(int j=0;j<cols;++j){
+                if((*board)[i][j] == '*') consider({i, j});
+            }
+        }
+    }
+    for(int k=0;k<overlay_size;++k){
+        if(overlay[k].second == '*'){
+            consider({overlay[k].first / cols, overlay[k].first % cols});
+        }
+    }
+    return best != -1;
+}
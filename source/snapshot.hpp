@@ -0,0 +1,56 @@
+#ifndef SNAPSHOT_HPP
+#define SNAPSHOT_HPP
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "direction.hpp"
+
+class Level;
+
+using SharedBoard = std::shared_ptr<std::vector<std::string>>;
+
+/**
+ * @brief Copy-on-write copy of the simulation state used by rollouts.
+ *
+ * The board is shared between snapshots; changes (eaten pellets) go into a
+ * small inline overlay, so copying a snapshot copies a pointer and a few
+ * cells without touching the heap. When the overlay is full the snapshot
+ * detaches and gets its own copy of the board. Head, score and lives follow
+ * the same rules as the THINKING state of the simulation.
+ */
+
+class LevelSnapshot {
+    public:
+        static SharedBoard static_board(const Level& level);
+        static LevelSnapshot capture(const SharedBoard& board, const Level& level, Point head, size_t score, size_t lives);
+
+        char get(Point p) const;
+        void set(Point p, char cell);
+        bool step(Dir direction);
+        bool nearest_food(Point& food) const;
+
+        Point head{0, 0};
+        Point start{0, 0};
+        size_t score = 0;
+        size_t lives = 0;
+        size_t food_eaten = 0;
+        int rows = 0;
+        int cols = 0;
+
+    private:
+        static const int OVERLAY_SIZE = 8;
+
+        SharedBoard board;
+        std::array<std::pair<int, char>, OVERLAY_SIZE> overlay;
+        int overlay_size = 0;
+        bool detached = false; //o tabuleiro já não é o estático do nível
+
+        void detach();
+};
+
+#endif
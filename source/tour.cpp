@@ -0,0 +1,168 @@
+#include "tour.hpp"
+#include "level.hpp"
+#include "search.hpp"
+#include "trace.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+/**
+ * @brief Computes the cost between every pair of sites.
+ *
+ * Runs one terrain-weighted Dijkstra per site, which yields its whole row of
+ * the matrix at once (N searches instead of N^2 point-to-point queries).
+ * The searches are independent and are spread over worker threads that
+ * take the next pending site from a shared counter.
+ *
+ * @param level Level to search.
+ * @param sites Start position followed by the food pellets.
+ * @param threads Number of worker threads; 0 uses every hardware thread.
+ * @return Matrix with costs (UNREACHABLE when there is no path) and the
+ * shortest-path tree of each site.
+ */
+
+DistanceMatrix compute_distance_matrix(const Level& level, const std::vector<Point>& sites, unsigned threads){
+    DistanceMatrix matrix;
+    const int n = sites.size();
+    matrix.cols = level.cols;
+    matrix.sites = sites;
+    matrix.dist.assign(n * n, UNREACHABLE);
+    matrix.parent.resize(n);
+
+    if(threads == 0){
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threads = std::min<unsigned>(threads, std::max(n, 1));
+
+    std::atomic<int> next_site{0};
+    auto worker = [&](){
+        std::vector<int> dist;
+        for(int i = next_site++; i < n; i = next_site++){
+            TRACE_SCOPE("site dijkstra");
+            dijkstra(level, sites[i], dist, &matrix.parent[i]);
+            for(int j=0;j<n;++j){
+                matrix.dist[i * n + j] = dist[sites[j].x * level.cols + sites[j].y];
+            }
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for(unsigned t=1;t<threads;++t){
+        pool.emplace_back(worker);
+    }
+    worker();
+    for(auto& thread : pool){
+        thread.join();
+    }
+    return matrix;
+}
+
+/**
+ * @brief Builds an open tour from site 0 visiting the closest unvisited site each time.
+ *
+ * Sites unreachable from site 0 are left out of the tour.
+ */
+
+std::vector<int> nearest_neighbour_tour(const DistanceMatrix& matrix){
+    const int n = matrix.sites.size();
+    std::vector<int> order;
+    std::vector<char> visited(n, 0);
+    if(n == 0) return order;
+
+    order.push_back(0);
+    visited[0] = 1;
+    int current = 0;
+
+    while(true){
+        int best = -1;
+        for(int j=0;j<n;++j){
+            if(!visited[j] && matrix.at(current, j) != UNREACHABLE
+                && (best == -1 || matrix.at(current, j) < matrix.at(current, best))){
+                best = j;
+            }
+        }
+        if(best == -1) break;
+        visited[best] = 1;
+        order.push_back(best);
+        current = best;
+    }
+    return order;
+}
+
+/**
+ * @brief Improves an open tour with 2-opt moves until none helps.
+ *
+ * Reverses segments order[i..k] (the start stays fixed). Since moving costs
+ * the terrain of the cell entered the matrix is not symmetric, so the gain
+ * also accounts for walking the reversed segment backwards; prefix sums of
+ * both directions make each move O(1) to evaluate.
+ *
+ * @return True if the tour was changed.
+ */
+
+bool improve_tour_2opt(const DistanceMatrix& matrix, std::vector<int>& order){
+    const int n = order.size();
+    bool changed = false;
+    bool improved = true;
+    std::vector<long> forward(n, 0), backward(n, 0);
+
+    while(improved){
+        improved = false;
+        for(int t=1;t<n;++t){
+            forward[t] = forward[t - 1] + matrix.at(order[t - 1], order[t]);
+            backward[t] = backward[t - 1] + matrix.at(order[t], order[t - 1]);
+        }
+
+        for(int i=1;i<n - 1 && !improved;++i){
+            for(int k=i + 1;k<n && !improved;++k){
+                long before = matrix.at(order[i - 1], order[i]) + (forward[k] - forward[i]);
+                long after = matrix.at(order[i - 1], order[k]) + (backward[k] - backward[i]);
+                if(k + 1 < n){
+                    before += matrix.at(order[k], order[k + 1]);
+                    after += matrix.at(order[i], order[k + 1]);
+                }
+                if(after < before){
+                    std::reverse(order.begin() + i, order.begin() + k + 1);
+                    improved = true;
+                    changed = true;
+                }
+            }
+        }
+    }
+    return changed;
+}
+
+/**
+ * @brief Total cost of walking the sites in the given order.
+ */
+
+long tour_cost(const DistanceMatrix& matrix, const std::vector<int>& order){
+    long cost = 0;
+    for(size_t t=1;t<order.size();++t){
+        cost += matrix.at(order[t - 1], order[t]);
+    }
+    return cost;
+}
+
+/**
+ * @brief Expands a tour into the cells the mouse walks through.
+ *
+ * @param path Receives every cell after the first site, up to the last one.
+ */
+
+void expand_tour(const DistanceMatrix& matrix, const std::vector<int>& order, std::vector<Point>& path){
+    path.clear();
+    std::vector<Point> leg;
+    for(size_t t=1;t<order.size();++t){
+        const std::vector<int>& parent = matrix.parent[order[t - 1]];
+        const Point& from = matrix.sites[order[t - 1]];
+        const Point& to = matrix.sites[order[t]];
+
+        leg.clear();
+        for(int idx = to.x * matrix.cols + to.y; idx != from.x * matrix.cols + from.y; idx = parent[idx]){
+            leg.push_back({idx / matrix.cols, idx % matrix.cols});
+        }
+        path.insert(path.end(), leg.rbegin(), leg.rend());
+    }
+}
@@ -0,0 +1,36 @@
+#ifndef TOUR_HPP
+#define TOUR_HPP
+
+#include <vector>
+
+#include "direction.hpp"
+
+class Level;
+
+/**
+ * @brief Pairwise shortest-path costs between a set of cells.
+ *
+ * `sites[0]` is where the tour starts (the mouse), the others are the food
+ * pellets. Row i holds the costs of the one search started at site i, and
+ * `parent[i]` keeps its shortest-path tree so any leg i -> j can be expanded
+ * into cells without searching again.
+ */
+
+struct DistanceMatrix {
+    int cols = 0;
+    std::vector<Point> sites;
+    std::vector<int> dist;
+    std::vector<std::vector<int>> parent;
+
+    int at(int from, int to) const {
+        return dist[from * sites.size() + to];
+    }
+};
+
+DistanceMatrix compute_distance_matrix(const Level& level, const std::vector<Point>& sites, unsigned threads = 0);
+std::vector<int> nearest_neighbour_tour(const DistanceMatrix& matrix);
+bool improve_tour_2opt(const DistanceMatrix& matrix, std::vector<int>& order);
+long tour_cost(const DistanceMatrix& matrix, const std::vector<int>& order);
+void expand_tour(const DistanceMatrix& matrix, const std::vector<int>& order, std::vector<Point>& path);
+
+#endif
@@ -0,0 +1,70 @@
+#include "benchmark.hpp"
+#include "maze.hpp"
+#include "player.hpp"
+#include "tour.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <thread>
+
+/**
+ * @brief Times the pairwise cost matrix of the all-food mode.
+ *
+ * Compares one A* call per ordered pair with one search per site (on one
+ * thread and on every hardware thread), then reports the cost of the
+ * nearest neighbour tour before and after 2-opt.
+ */
+
+void bench_tour(){
+    const unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    Level maze = generate_maze(151, 151, 4, 15, 20);
+    std::vector<Point> cells = open_cells(maze);
+    Player player(maze);
+
+    std::cout << "\n[ALL-FOOD TOUR ON MAZE 151x151 (" << threads << " threads)]\n";
+    std::cout << std::setw(8) << "pellets" << std::setw(14) << "A* NxN ms" << std::setw(14) << "matrix 1t"
+              << std::setw(14) << "matrix Nt" << std::setw(12) << "NN cost" << std::setw(12) << "2-opt" << "\n";
+
+    for(int pellets : {10, 25, 50}){
+        std::mt19937 gen(pellets);
+        std::shuffle(cells.begin(), cells.end(), gen);
+        std::vector<Point> sites{maze.start_mouse};
+        for(int k=0;k<(int)cells.size() && (int)sites.size()<=pellets;++k){
+            if(cells[k] != maze.start_mouse) sites.push_back(cells[k]);
+        }
+
+        double astar_ms = -1;
+        if(pellets <= 25){
+            auto begin = Clock::now();
+            for(const Point& from : sites){
+                for(const Point& to : sites){
+                    if(from != to) player.computed_path_A(from, to);
+                }
+            }
+            astar_ms = elapsed_ms(begin);
+        }
+
+        auto begin = Clock::now();
+        compute_distance_matrix(maze, sites, 1);
+        double single_ms = elapsed_ms(begin);
+
+        begin = Clock::now();
+        DistanceMatrix matrix = compute_distance_matrix(maze, sites, threads);
+        double parallel_ms = elapsed_ms(begin);
+
+        std::vector<int> order = nearest_neighbour_tour(matrix);
+        long nn_cost = tour_cost(matrix, order);
+        improve_tour_2opt(matrix, order);
+
+        std::cout << std::fixed << std::setprecision(1) << std::setw(8) << pellets;
+        if(astar_ms < 0){
+            std::cout << std::setw(14) << "-";
+        }else{
+            std::cout << std::setw(14) << astar_ms;
+        }
+        std::cout << std::setw(14) << single_ms << std::setw(14) << parallel_ms
+                  << std::setw(12) << nn_cost << std::setw(12) << tour_cost(matrix, order) << "\n";
+    }
+}
@@ -0,0 +1,114 @@
+#include "trace.hpp"
+
+#ifdef MOUZE_TRACE
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace {
+    const size_t RING_CAPACITY = 1 << 16; //eventos por thread (potência de 2)
+
+    /**
+     * @brief Events of one thread.
+     *
+     * Only the owning thread writes; `written` is published with release
+     * order after each slot so the exporter sees complete events.
+     */
+
+    struct TraceRing {
+        std::unique_ptr<TraceEvent[]> events{new TraceEvent[RING_CAPACITY]};
+        std::atomic<std::uint64_t> written{0};
+        int tid = 0;
+    };
+
+    const auto trace_start = std::chrono::steady_clock::now();
+
+    //o mutex só é usado quando uma thread cria o seu buffer e na exportação
+    std::mutex rings_mutex;
+    std::vector<std::unique_ptr<TraceRing>> rings;
+
+    TraceRing& thread_ring(){
+        thread_local TraceRing* ring = nullptr;
+        if(ring == nullptr){
+            std::lock_guard<std::mutex> lock(rings_mutex);
+            rings.push_back(std::make_unique<TraceRing>());
+            ring = rings.back().get();
+            ring->tid = rings.size();
+        }
+        return *ring;
+    }
+
+    void write_name(std::ostream& out, const char* name){
+        out << '"';
+        for(const char* c = name; *c; ++c){
+            if(*c == '"' || *c == '\\') out << '\\';
+            out << *c;
+        }
+        out << '"';
+    }
+}
+
+/**
+ * @brief Appends an event to the ring buffer of the calling thread.
+ *
+ * @param a Counter value, or x of a POINT.
+ * @param b y of a POINT.
+ */
+
+void trace_emit(TraceKind kind, const char* name, std::int32_t a, std::int32_t b){
+    TraceRing& ring = thread_ring();
+    const std::uint64_t n = ring.written.load(std::memory_order_relaxed);
+    const auto now = std::chrono::steady_clock::now() - trace_start;
+    ring.events[n & (RING_CAPACITY - 1)] = {
+        static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count()),
+        name, a, b, kind
+    };
+    ring.written.store(n + 1, std::memory_order_release);
+}
+
+/**
+ * @brief Writes the events of every thread in Chrome trace JSON format.
+ *
+ * The file can be opened in chrome://tracing or ui.perfetto.dev. Should be
+ * called when no other thread is emitting events.
+ *
+ * @return False if the file could not be written.
+ */
+
+bool export_chrome_trace(const std::string& filename){
+    std::ofstream out(filename);
+    if(!out.is_open()){
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(rings_mutex);
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    bool first = true;
+    for(const auto& ring : rings){
+        const std::uint64_t written = ring->written.load(std::memory_order_acquire);
+        const std::uint64_t begin = written > RING_CAPACITY ? written - RING_CAPACITY : 0;
+        for(std::uint64_t i = begin; i < written; ++i){
+            const TraceEvent& event = ring->events[i & (RING_CAPACITY - 1)];
+            out << (first ? "\n" : ",\n") << "{\"name\":";
+            write_name(out, event.name);
+            //Chrome usa microssegundos, com fração
+            out << ",\"pid\":1,\"tid\":" << ring->tid << ",\"ts\":" << event.time_ns / 1000 << '.'
+                << (event.time_ns % 1000) / 100 << (event.time_ns % 100) / 10 << event.time_ns % 10;
+            switch(event.kind){
+                case TraceKind::BEGIN: out << ",\"ph\":\"B\"}"; break;
+                case TraceKind::END: out << ",\"ph\":\"E\"}"; break;
+                case TraceKind::COUNTER: out << ",\"ph\":\"C\",\"args\":{\"value\":" << event.a << "}}"; break;
+                case TraceKind::POINT: out << ",\"ph\":\"C\",\"args\":{\"x\":" << event.a << ",\"y\":" << event.b << "}}"; break;
+            }
+            first = false;
+        }
+    }
+    out << "\n]}\n";
+    return out.good();
+}
+
+#endif
@@ -0,0 +1,83 @@
+#ifndef TRACE_HPP
+#define TRACE_HPP
+
+#include <string>
+
+/**
+ * @brief Event tracing of the simulation, exported as Chrome trace JSON.
+ *
+ * Built only when MOUZE_TRACE is defined (e.g. -DMOUZE_TRACE); otherwise
+ * every TRACE_* macro expands to nothing and no tracing code is compiled.
+ *
+ * Each thread writes fixed-size events into its own ring buffer, so
+ * emitting an event takes no lock and does not allocate (except for the
+ * buffer itself, on the first event of the thread). When a buffer is full
+ * the oldest events are overwritten. Names must be string literals or
+ * other strings that live until the export.
+ *
+ * - TRACE_SCOPE(name): slice from here to the end of the enclosing block;
+ * - TRACE_BEGIN(name) / TRACE_END(name): slice with explicit ends;
+ * - TRACE_COUNTER(name, value): value of a counter at this moment;
+ * - TRACE_POINT(name, x, y): position (shown as a two-series counter).
+ */
+
+#ifdef MOUZE_TRACE
+
+#include <cstdint>
+
+enum class TraceKind : std::uint8_t {
+    BEGIN,
+    END,
+    COUNTER,
+    POINT
+};
+
+struct TraceEvent {
+    std::uint64_t time_ns; //desde o início do rastreamento
+    const char* name;
+    std::int32_t a;
+    std::int32_t b;
+    TraceKind kind;
+};
+
+void trace_emit(TraceKind kind, const char* name, std::int32_t a = 0, std::int32_t b = 0);
+bool export_chrome_trace(const std::string& filename);
+
+class TraceScope {
+    public:
+        explicit TraceScope(const char* scope_name) : name(scope_name){
+            trace_emit(TraceKind::BEGIN, name);
+        }
+        ~TraceScope(){
+            trace_emit(TraceKind::END, name);
+        }
+        TraceScope(const TraceScope&) = delete;
+        TraceScope& operator=(const TraceScope&) = delete;
+
+    private:
+        const char* name;
+};
+
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+#define TRACE_SCOPE(name) TraceScope TRACE_CONCAT(trace_scope_, __LINE__)(name)
+#define TRACE_BEGIN(name) trace_emit(TraceKind::BEGIN, (name))
+#define TRACE_END(name) trace_emit(TraceKind::END, (name))
+#define TRACE_COUNTER(name, value) trace_emit(TraceKind::COUNTER, (name), static_cast<std::int32_t>(value))
+#define TRACE_POINT(name, x, y) trace_emit(TraceKind::POINT, (name), (x), (y))
+
+#else
+
+inline bool export_chrome_trace(const std::string&){
+    return false;
+}
+
+#define TRACE_SCOPE(name) ((void)0)
+#define TRACE_BEGIN(name) ((void)0)
+#define TRACE_END(name) ((void)0)
+#define TRACE_COUNTER(name, value) ((void)0)
+#define TRACE_POINT(name, x, y) ((void)0)
+
+#endif
+
+#endif
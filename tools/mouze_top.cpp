@@ -0,0 +1,146 @@
+/**
+ * @file mouze_top.cpp
+ * @brief Live view of the simulations started with --stats.
+ *
+ * Reads the shared-memory segments published by MouzeSimulation (see
+ * live_stats.hpp) without slowing the simulations down: each refresh only
+ * copies their last sample.
+ *
+ *     g++ -std=c++17 -O2 -Isource tools/mouze_top.cpp source/live_stats.cpp -o mouze-top
+ *     mouze-top [--once] [--interval <ms>] [/mouze-<pid> ...]
+ *
+ * Without names every /dev/shm/mouze-* segment is shown. Ticks per second
+ * come from the tick counter between two refreshes.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <signal.h>
+
+#include "live_stats.hpp"
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    volatile std::sig_atomic_t stop_requested = 0;
+
+    void request_stop(int){
+        stop_requested = 1;
+    }
+
+    struct Watched {
+        std::unique_ptr<LiveStats> segment;
+        std::uint64_t last_ticks = 0;
+        Clock::time_point last_seen;
+        bool seen = false;
+    };
+
+    std::vector<std::string> find_segments(){
+        std::vector<std::string> names;
+        std::error_code error;
+        for(const auto& entry : std::filesystem::directory_iterator("/dev/shm", error)){
+            const std::string file = entry.path().filename().string();
+            if(file.rfind("mouze-", 0) == 0){
+                names.push_back("/" + file);
+            }
+        }
+        return names;
+    }
+
+    void print_help(){
+        std::cout << "Usage: mouze-top [--once] [--interval <ms>] [<segment> ...]\n";
+        std::cout << "  --once           Print one table and exit.\n";
+        std::cout << "  --interval <ms>  Time between refreshes. Default = 1000.\n";
+        std::cout << "  <segment>        Shared-memory name shown by mouze --stats (e.g. /mouze-1234). Default = every /dev/shm/mouze-*.\n";
+    }
+}
+
+int main(int argc, char* argv[]){
+    bool once = false;
+    int interval_ms = 1000;
+    std::vector<std::string> requested;
+    for(int i=1;i<argc;++i){
+        std::string arg = argv[i];
+        if(arg == "-h" || arg == "--help"){
+            print_help();
+            return 0;
+        }else if(arg == "--once"){
+            once = true;
+        }else if(arg == "--interval" && i + 1 < argc){
+            interval_ms = std::max(50, std::stoi(argv[++i]));
+        }else if(!arg.empty() && arg[0] == '/'){
+            requested.push_back(arg);
+        }else{
+            std::cout << "Error: Unknown argument '" << arg << "'.\n\n";
+            print_help();
+            return 1;
+        }
+    }
+
+    std::signal(SIGINT, request_stop);
+    std::map<std::string, Watched> watched;
+
+    //com --once, duas leituras separadas por um intervalo para ter ticks/s
+    for(int round = 0; !stop_requested; ++round){
+        const Clock::time_point now = Clock::now();
+        std::vector<std::string> names = requested.empty() ? find_segments() : requested;
+
+        std::ostringstream table;
+        table << std::left << std::setw(14) << "SEGMENT" << std::right << std::setw(8) << "PID" << "  " << std::left
+              << std::setw(13) << "PLANNER" << std::setw(11) << "STATE" << std::right << std::setw(6) << "LEVEL"
+              << std::setw(9) << "SCORE" << std::setw(6) << "LIVES" << std::setw(8) << "FOOD" << std::setw(11) << "TICKS/S"
+              << std::setw(12) << "THINK us" << std::setw(12) << "MEAN us" << "\n";
+
+        for(const std::string& name : names){
+            Watched& entry = watched[name];
+            if(!entry.segment){
+                entry.segment = std::make_unique<LiveStats>();
+                if(!entry.segment->attach(name)){
+                    entry.segment.reset();
+                    continue;
+                }
+            }
+            LiveSample sample;
+            if(!entry.segment->read(sample)) continue;
+
+            const bool alive = kill((pid_t)sample.pid, 0) == 0;
+            double rate = 0;
+            if(entry.seen){
+                const double seconds = std::chrono::duration<double>(now - entry.last_seen).count();
+                rate = seconds > 0 ? (sample.ticks - entry.last_ticks) / seconds : 0;
+            }
+            entry.last_ticks = sample.ticks;
+            entry.last_seen = now;
+            entry.seen = true;
+
+            table << std::left << std::setw(14) << name << std::right << std::setw(8) << sample.pid << "  " << std::left
+                  << std::setw(13) << sample.planner << std::setw(11) << (alive ? sample.state : "(gone)")
+                  << std::right << std::setw(6) << sample.level + 1 << std::setw(9) << sample.score << std::setw(6) << sample.lives
+                  << std::setw(8) << (std::to_string(sample.eaten) + "/" + std::to_string(sample.food))
+                  << std::fixed << std::setprecision(1) << std::setw(11) << rate
+                  << std::setw(12) << sample.think_ns_last / 1000.0
+                  << std::setw(12) << (sample.think_calls ? sample.think_ns_total / 1000.0 / sample.think_calls : 0.0) << "\n";
+        }
+
+        if(!once){
+            std::cout << "\x1b[H\x1b[2J"; //limpa o terminal
+        }
+        if(!once || round == 1){
+            std::cout << table.str() << std::flush;
+            if(once) break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(interval_ms));
+    }
+    return 0;
+}